@@ -0,0 +1,131 @@
+/***********************************************************************************[AllocBench.cc]
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT
+NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT
+OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+**************************************************************************************************/
+
+// Micro-benchmark of the 'ClauseAllocator': allocate problem and learnt clauses, delete most of the
+// learnt ones as 'reduceDB()' does, and compact the arena both ways 'Solver' does it -- a full
+// collection that copies every live clause ('garbageCollect()') and one that only copies the learnt
+// region ('collectLearnts()'). The references are relocated through a list, like the watchers.
+//
+//   make bench && build/bench/AllocBench [nclauses] [rounds]
+//
+// (or with '-D MINISAT_SEGMENTED_ARENA' for the other arena)
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <chrono>
+
+#include "minisat/mtl/Vec.h"
+#include "minisat/core/SolverTypes.h"
+
+using namespace Minisat;
+
+static uint64_t rnd_state = 88172645463325252ULL;
+static inline uint64_t xorshift() {
+    rnd_state ^= rnd_state << 13;
+    rnd_state ^= rnd_state >> 7;
+    rnd_state ^= rnd_state << 17;
+    return rnd_state; }
+
+// Mostly short clauses, with a tail of long ones:
+static void randomClause(vec<Lit>& ps, int nvars) {
+    uint64_t r    = xorshift();
+    int      size = 2 + (r % 4 == 0 ? r / 4 % 64 : r / 4 % 6);
+    ps.clear();
+    for (int i = 0; i < size; i++)
+        ps.push(mkLit(xorshift() % nvars, xorshift() & 1)); }
+
+// A checksum of the live clauses, so the two ways of collecting can be compared:
+static uint64_t checksum(const ClauseAllocator& ca, const vec<CRef>& refs) {
+    uint64_t sum = 0;
+    for (int i = 0; i < refs.size(); i++){
+        const Clause& c = ca[refs[i]];
+        for (int j = 0; j < c.size(); j++)
+            sum = sum * 31 + toInt(c[j]); }
+    return sum; }
+
+typedef std::chrono::steady_clock Clock;
+static double since(Clock::time_point t0) { return std::chrono::duration<double>(Clock::now() - t0).count(); }
+
+static uint64_t run(bool learnts_only, int nclauses, int rounds) {
+    ClauseAllocator ca(1024*1024);
+    vec<CRef>       problem, learnts;
+    vec<Lit>        ps;
+    const int       nvars = 100000;
+    rnd_state = 88172645463325252ULL;
+
+    double t_alloc = 0, t_free = 0, t_collect = 0;
+    Clock::time_point t0 = Clock::now();
+    for (int i = 0; i < nclauses; i++){
+        randomClause(ps, nvars);
+        problem.push(ca.alloc(ps, false)); }
+    t_alloc += since(t0);
+
+    for (int r = 0; r < rounds; r++){
+        // Conflicts:
+        t0 = Clock::now();
+        for (int i = 0; i < nclauses / 4; i++){
+            randomClause(ps, nvars);
+            learnts.push(ca.alloc(ps, true)); }
+        t_alloc += since(t0);
+
+        // Reduction, keeping about a third:
+        t0 = Clock::now();
+        int j = 0;
+        for (int i = 0; i < learnts.size(); i++)
+            if (xorshift() % 3 == 0)
+                learnts[j++] = learnts[i];
+            else
+                ca.free(learnts[i]);
+        learnts.shrink(learnts.size() - j);
+        t_free += since(t0);
+
+        // Collection:
+        t0 = Clock::now();
+        if (learnts_only){
+            ClauseAllocator to(0, ca.size(true) - ca.wasted(true));
+            for (int i = 0; i < learnts.size(); i++)
+                ca.reloc(learnts[i], to);
+            ca.moveProblemClausesTo(to);
+            to.moveTo(ca);
+        }else{
+            ClauseAllocator to(ca.size(false) - ca.wasted(false), ca.size(true) - ca.wasted(true));
+            for (int i = 0; i < problem.size(); i++)
+                ca.reloc(problem[i], to);
+            for (int i = 0; i < learnts.size(); i++)
+                ca.reloc(learnts[i], to);
+            to.moveTo(ca); }
+        t_collect += since(t0);
+    }
+
+    printf("%-12s alloc %8.3f s   free %8.3f s   collect %8.3f s   total %8.3f s   (%" PRIu64 " MB live)\n",
+           learnts_only ? "learnt-only" : "full", t_alloc, t_free, t_collect, t_alloc + t_free + t_collect,
+           (uint64_t)ca.size() * ClauseAllocator::Unit_Size >> 20);
+    return checksum(ca, problem) * 17 + checksum(ca, learnts);
+}
+
+int main(int argc, char** argv) {
+    int nclauses = argc > 1 ? atoi(argv[1]) : 2000000;
+    int rounds   = argc > 2 ? atoi(argv[2]) : 20;
+    printf("%d problem clauses, %d rounds of %d learnt clauses\n", nclauses, rounds, nclauses / 4);
+
+    uint64_t a = run(false, nclauses, rounds);
+    uint64_t b = run(true,  nclauses, rounds);
+    if (a != b) {
+        printf("ERROR: the collections kept different clauses\n");
+        return 1; }
+    return 0;
+}
@@ -0,0 +1,116 @@
+/************************************************************************************[HeapBench.cc]
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT
+NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT
+OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+**************************************************************************************************/
+
+// Micro-benchmark of 'Heap' against 'QuadHeap' with a VSIDS-like workload: bump (decrease) a few
+// random variables, remove the best ones as decisions and insert them again as on backtracking.
+//
+//   make bench && build/bench/HeapBench [nvars] [rounds]
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <chrono>
+
+#include "minisat/mtl/Vec.h"
+#include "minisat/mtl/Heap.h"
+#include "minisat/mtl/QuadHeap.h"
+
+using namespace Minisat;
+
+struct ActLt {
+    const vec<double>& activity;
+    ActLt(const vec<double>& act) : activity(act) { }
+    bool operator () (int x, int y) const { return activity[x] > activity[y]; }
+    typedef double Key;
+    Key  key    (int x)        const { return activity[x]; }
+    bool better (Key a, Key b) const { return a > b; }
+};
+
+static uint64_t rnd_state = 88172645463325252ULL;
+static inline uint64_t xorshift() {
+    rnd_state ^= rnd_state << 13;
+    rnd_state ^= rnd_state >> 7;
+    rnd_state ^= rnd_state << 17;
+    return rnd_state; }
+
+// Returns a checksum of the keys of the removed elements, so the two heaps can be compared (elements
+// with equal keys may come out in a different order).
+template<class H>
+static uint64_t run(const char* name, int nvars, int rounds) {
+    vec<double> activity(nvars, 0);
+    H           heap((ActLt(activity)));
+    vec<int>    removed;
+    uint64_t    checksum = 0;
+    double      inc      = 1;
+    rnd_state = 88172645463325252ULL;
+
+    double t_insert = 0, t_decrease = 0, t_remove = 0;
+    typedef std::chrono::steady_clock clock;
+
+    clock::time_point t0 = clock::now();
+    for (int v = 0; v < nvars; v++)
+        heap.insert(v);
+    t_insert += std::chrono::duration<double>(clock::now() - t0).count();
+
+    for (int r = 0; r < rounds; r++) {
+        // Conflict analysis: bump some variables.
+        t0 = clock::now();
+        for (int i = 0; i < 32; i++) {
+            int v = xorshift() % nvars;
+            activity[v] += inc;
+            if (heap.inHeap(v)) heap.decrease(v); }
+        inc *= 1.05;
+        if (inc > 1e100) {
+            for (int v = 0; v < nvars; v++) activity[v] *= 1e-100;
+            inc *= 1e-100;
+            heap.refresh(); }
+        t_decrease += std::chrono::duration<double>(clock::now() - t0).count();
+
+        // Decisions:
+        t0 = clock::now();
+        removed.clear();
+        for (int i = 0; i < 16 && !heap.empty(); i++) {
+            int v = heap.removeMin();
+            removed.push(v);
+            uint64_t k; memcpy(&k, &activity[v], sizeof(k));
+            checksum = checksum * 31 + k; }
+        t_remove += std::chrono::duration<double>(clock::now() - t0).count();
+
+        // Backtracking:
+        t0 = clock::now();
+        for (int i = 0; i < removed.size(); i++)
+            heap.insert(removed[i]);
+        t_insert += std::chrono::duration<double>(clock::now() - t0).count();
+    }
+
+    printf("%-10s insert %8.3f s   decrease %8.3f s   removeMin %8.3f s   total %8.3f s\n", name, t_insert, t_decrease, t_remove,
+           t_insert + t_decrease + t_remove);
+    return checksum;
+}
+
+int main(int argc, char** argv) {
+    int nvars  = argc > 1 ? atoi(argv[1]) : 1000000;
+    int rounds = argc > 2 ? atoi(argv[2]) : 200000;
+    printf("%d variables, %d rounds\n", nvars, rounds);
+
+    uint64_t a = run<Heap<ActLt> >    ("Heap",     nvars, rounds);
+    uint64_t b = run<QuadHeap<ActLt> >("QuadHeap", nvars, rounds);
+    if (a != b) {
+        printf("ERROR: the heaps removed different elements\n");
+        return 1; }
+    return 0;
+}
@@ -0,0 +1,132 @@
+/***********************************************************************************[ParseBench.cc]
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT
+NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT
+OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+**************************************************************************************************/
+
+// Micro-benchmark of the DIMACS parsers: the stream parser ('StreamBuffer'), the mapped parser with
+// one and with all threads, and the gzip path ('ThreadedStreamBuffer'). The clauses go into a sink
+// that only sums them, so this measures the parsers and not the solver. Without a file, a random
+// problem is written to a temporary file first.
+//
+//   make bench && build/bench/ParseBench [file.cnf] [nclauses]
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include <chrono>
+
+#include <zlib.h>
+
+#include "minisat/utils/WriteUtils.h"
+#include "minisat/core/Dimacs.h"
+
+using namespace Minisat;
+
+struct Sink {
+    int      vars;
+    uint64_t clauses, lits, sum;
+    Sink() : vars(0), clauses(0), lits(0), sum(0) { }
+
+    int  nVars   () const                             { return vars; }
+    Var  newVar  ()                                   { return vars++; }
+    void reserve (int, uint64_t, uint64_t)            { }
+    bool addClause_(vec<Lit>& ps)                     {
+        clauses++;
+        lits += ps.size();
+        for (int i = 0; i < ps.size(); i++)
+            sum = sum * 31 + toInt(ps[i]);
+        return true; }
+};
+
+static uint64_t rnd_state = 88172645463325252ULL;
+static inline uint64_t xorshift() {
+    rnd_state ^= rnd_state << 13;
+    rnd_state ^= rnd_state >> 7;
+    rnd_state ^= rnd_state << 17;
+    return rnd_state; }
+
+static bool writeRandom(const char* path, int nclauses) {
+    const int nvars = 1000000;
+    FILE*     f     = fopen(path, "wb");
+    if (f == NULL) return false;
+    WriteBuffer out(f);
+    out.put("c random benchmark problem\np cnf "); out.putInt(nvars); out.put(' '); out.putInt(nclauses); out.put('\n');
+    for (int i = 1; i < nclauses; i++){
+        int size = 2 + xorshift() % 6;
+        for (int j = 0; j < size; j++){
+            int v = 1 + xorshift() % nvars;
+            out.putInt(xorshift() & 1 ? -v : v); out.put(' '); }
+        out.put("0\n"); }
+    // (the last one has the last variable, so the header is right)
+    out.putInt(nvars); out.put(" 0\n");
+    bool good = out.flush();
+    return fclose(f) == 0 && good;
+}
+
+static bool writeGzip(const char* from, const char* to) {
+    MappedFile f(from);
+    gzFile     gz = gzopen(to, "wb1");
+    if (f.data == NULL || gz == NULL) return false;
+    bool good = gzwrite(gz, f.data, f.size) == (int)f.size;
+    return gzclose(gz) == Z_OK && good;
+}
+
+typedef std::chrono::steady_clock Clock;
+
+template<class Parse>
+static uint64_t run(const char* name, uint64_t bytes, Parse parse) {
+    Sink S;
+    Clock::time_point t0 = Clock::now();
+    parse(S);
+    double t = std::chrono::duration<double>(Clock::now() - t0).count();
+    printf("%-12s %8.3f s   %8.1f MB/s   %10.0f clauses/s\n", name, t, bytes / t / 1048576, S.clauses / t);
+    return S.sum * 17 + S.vars;
+}
+
+int main(int argc, char** argv) {
+    char        tmp[]    = "/tmp/parsebenchXXXXXX";
+    char        gzpath[] = "/tmp/parsebenchXXXXXX";
+    const char* path     = argc > 1 ? argv[1] : NULL;
+    int         nclauses = argc > 2 ? atoi(argv[2]) : 4000000;
+    if (path == NULL){
+        int fd = mkstemp(tmp);
+        if (fd < 0 || close(fd) != 0 || !writeRandom(tmp, nclauses)) {
+            printf("ERROR: could not write %s\n", tmp);
+            return 1; }
+        path = tmp; }
+
+    int fd = mkstemp(gzpath);
+    if (fd < 0 || close(fd) != 0 || !writeGzip(path, gzpath)) {
+        printf("ERROR: could not write %s\n", gzpath);
+        return 1; }
+
+    uint64_t bytes = MappedFile(path).size;
+    printf("%s: %.1f MB\n", path, bytes / 1048576.0);
+
+    uint64_t a = run("stream", bytes, [&](Sink& S) {
+        gzFile in = gzopen(path, "rb");
+        parse_DIMACS(in, S);
+        gzclose(in); });
+    uint64_t b = run("mapped", bytes, [&](Sink& S) { parse_DIMACS(path, S, 1); });
+    uint64_t c = run("threads", bytes, [&](Sink& S) { parse_DIMACS(path, S, 0); });
+    uint64_t d = run("gzip", bytes, [&](Sink& S) { parse_DIMACS(gzpath, S, 0); });
+
+    unlink(gzpath);
+    if (path == tmp) unlink(tmp);
+    if (a != b || a != c || a != d) {
+        printf("ERROR: the parsers read different clauses\n");
+        return 1; }
+    return 0;
+}
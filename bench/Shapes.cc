@@ -0,0 +1,203 @@
+/***************************************************************************************[Shapes.cc]
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT
+NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT
+OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+**************************************************************************************************/
+
+// Generator of the synthetic problems of the benchmark corpus (see 'corpus.txt'). The 'Solver' is a
+// propagator of a MinisatID 'PCSolver' and cannot be driven on its own, so its hot paths are
+// measured on whole runs, on problems that stress one of them each, with the timers of its
+// statistics registry (see 'macro.py'):
+//
+//   chains  <vars> <length> <seed>   -- random 3-SAT over the heads of long binary implication
+//                                       chains: binary watchers and long propagation sequences
+//   hubs    <vars> <hubs> <seed>     -- long clauses that all contain some of a few hub literals:
+//                                       very long watch lists, on which the blockers decide
+//   random  <vars> <ratio%> <seed>   -- random 3-SAT: conflict analysis and minimization
+//   php     <holes>                  -- the pigeon hole principle: long learnt clauses
+//   gates   <inputs> <gates> <seed>  -- a miter of two copies of a random AND/XOR circuit: many
+//                                       gate definitions, for variable elimination
+//   long    <vars> <length> <seed>   -- random 3-SAT and as many clauses of 'length' literals: the
+//                                       search for replacement watches in long clauses
+//
+// The output is a function of the arguments only, so a corpus is pinned by its command lines.
+//
+//   make bench && build/bench/Shapes random 300 426 1 > random.cnf
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "minisat/mtl/Vec.h"
+#include "minisat/utils/WriteUtils.h"
+
+using namespace Minisat;
+
+static uint64_t rnd_state;
+static inline uint64_t xorshift() {
+    rnd_state ^= rnd_state << 13;
+    rnd_state ^= rnd_state >> 7;
+    rnd_state ^= rnd_state << 17;
+    return rnd_state; }
+
+static void seed(uint64_t s) {
+    rnd_state = 88172645463325252ULL ^ (s * 0x9E3779B97F4A7C15ULL);
+    for (int i = 0; i < 16; i++) xorshift(); }
+
+static int randomLit(int nvars) {
+    int v = 1 + xorshift() % nvars;
+    return xorshift() & 1 ? -v : v; }
+
+// Clauses are collected first, for the header:
+struct Cnf {
+    int      nvars;
+    vec<int> lits;       // Clauses one after the other, each ended by 0.
+    int      nclauses;
+    Cnf() : nvars(0), nclauses(0) { }
+
+    int  newVar ()                    { return ++nvars; }
+    void add    (int a)               { lits.push(a); lits.push(0); nclauses++; }
+    void add    (int a, int b)        { lits.push(a); lits.push(b); lits.push(0); nclauses++; }
+    void add    (int a, int b, int c) { lits.push(a); lits.push(b); lits.push(c); lits.push(0); nclauses++; }
+    void add    (const vec<int>& c)   { for (int i = 0; i < c.size(); i++) lits.push(c[i]); lits.push(0); nclauses++; }
+
+    bool write(FILE* f) const {
+        WriteBuffer out(f);
+        out.put("p cnf "); out.putInt(nvars); out.put(' '); out.putInt(nclauses); out.put('\n');
+        for (int i = 0; i < lits.size(); i++){
+            out.putInt(lits[i]);
+            out.put(lits[i] == 0 ? '\n' : ' '); }
+        return out.flush(); }
+};
+
+static void chains(Cnf& cnf, int nheads, int length) {
+    // Variables 1..nheads are the heads, each implies a chain whose last variable implies the head
+    // of another chain negatively, so the chains also link up:
+    for (int h = 1; h <= nheads; h++) cnf.newVar();
+    for (int h = 1; h <= nheads; h++){
+        int prev = h;
+        for (int i = 0; i < length; i++){
+            int v = cnf.newVar();
+            cnf.add(-prev, v);
+            prev = v; }
+        cnf.add(-prev, -(int)(1 + xorshift() % nheads)); }
+    for (int i = 0; i < nheads * 2; i++)
+        cnf.add(randomLit(nheads), randomLit(nheads), randomLit(nheads));
+}
+
+static void hubs(Cnf& cnf, int nvars, int nhubs) {
+    for (int v = 0; v < nvars; v++) cnf.newVar();
+    vec<int> c;
+    for (int i = 0; i < nvars * 4; i++){
+        c.clear();
+        c.push(randomLit(nhubs));
+        c.push(randomLit(nhubs));
+        for (int j = 0; j < 6; j++)
+            c.push(nhubs + 1 + xorshift() % (nvars - nhubs));
+        for (int j = 2; j < c.size(); j++)
+            if (xorshift() & 1) c[j] = -c[j];
+        cnf.add(c); }
+    for (int i = 0; i < nvars * 3; i++)
+        cnf.add(randomLit(nvars), randomLit(nvars), randomLit(nvars));
+}
+
+static void random3(Cnf& cnf, int nvars, int ratio) {
+    for (int v = 0; v < nvars; v++) cnf.newVar();
+    for (int i = 0; i < (int64_t)nvars * ratio / 100; i++)
+        cnf.add(randomLit(nvars), randomLit(nvars), randomLit(nvars));
+}
+
+static void php(Cnf& cnf, int holes) {
+    int pigeons = holes + 1;
+    for (int v = 0; v < pigeons * holes; v++) cnf.newVar();
+    vec<int> c;
+    for (int p = 0; p < pigeons; p++){
+        c.clear();
+        for (int h = 0; h < holes; h++) c.push(1 + p * holes + h);
+        cnf.add(c); }
+    for (int h = 0; h < holes; h++)
+        for (int p = 0; p < pigeons; p++)
+            for (int q = p + 1; q < pigeons; q++)
+                cnf.add(-(1 + p * holes + h), -(1 + q * holes + h));
+}
+
+static void long3(Cnf& cnf, int nvars, int length) {
+    random3(cnf, nvars, 420);
+    vec<int> c;
+    for (int i = 0; i < nvars * 4; i++){
+        c.clear();
+        for (int j = 0; j < length; j++)
+            c.push(randomLit(nvars));
+        cnf.add(c); }
+}
+
+// Tseitin encoding of 'g = a & b' or 'g = a ^ b':
+static int gate(Cnf& cnf, bool is_xor, int a, int b) {
+    int g = cnf.newVar();
+    if (is_xor){
+        cnf.add(-g,  a,  b); cnf.add(-g, -a, -b);
+        cnf.add( g, -a,  b); cnf.add( g,  a, -b);
+    }else{
+        cnf.add(-g, a); cnf.add(-g, b); cnf.add(g, -a, -b); }
+    return g; }
+
+static void gates(Cnf& cnf, int ninputs, int ngates) {
+    vec<int> inputs;
+    for (int i = 0; i < ninputs; i++) inputs.push(cnf.newVar());
+
+    // The same circuit twice, the second one with the operands of each gate swapped and with its
+    // XOR gates made of AND gates:
+    vec<int> shape;
+    for (int i = 0; i < ngates; i++){
+        shape.push((int)(xorshift() % (ninputs + i)));
+        shape.push((int)(xorshift() % (ninputs + i)));
+        shape.push(xorshift() % 4 == 0); }
+    int outs[2];
+    for (int copy = 0; copy < 2; copy++){
+        vec<int> nodes;
+        inputs.copyTo(nodes);
+        for (int i = 0; i < ngates; i++){
+            int  a      = nodes[shape[3*i]], b = nodes[shape[3*i+1]];
+            bool is_xor = shape[3*i+2];
+            if (copy == 0)
+                nodes.push(gate(cnf, is_xor, a, b));
+            else if (!is_xor)
+                nodes.push(gate(cnf, false, b, a));
+            else
+                nodes.push(-gate(cnf, false, -gate(cnf, false, b, -a), -gate(cnf, false, -b, a))); }
+        outs[copy] = nodes.last(); }
+
+    // The outputs differ (unsatisfiable):
+    cnf.add(gate(cnf, true, outs[0], outs[1]));
+}
+
+int main(int argc, char** argv) {
+    const char* shape = argc > 1 ? argv[1] : "";
+    int         a     = argc > 2 ? atoi(argv[2]) : 0;
+    int         b     = argc > 3 ? atoi(argv[3]) : 0;
+    seed(argc > 4 ? atoi(argv[4]) : 0);
+
+    Cnf cnf;
+    if      (strcmp(shape, "chains") == 0 && a > 0 && b > 0)     chains(cnf, a, b);
+    else if (strcmp(shape, "hubs")   == 0 && a > 0 && b > 0 && b < a) hubs(cnf, a, b);
+    else if (strcmp(shape, "random") == 0 && a > 0 && b > 0)     random3(cnf, a, b);
+    else if (strcmp(shape, "php")    == 0 && a > 0)              php(cnf, a);
+    else if (strcmp(shape, "gates")  == 0 && a > 0 && b > 0)     gates(cnf, a, b);
+    else if (strcmp(shape, "long")   == 0 && a > 0 && b > 0)     long3(cnf, a, b);
+    else {
+        fprintf(stderr, "USAGE: %s chains|hubs|random|php|gates|long <n> <m> <seed> (see Shapes.cc)\n", argv[0]);
+        return 1; }
+
+    return cnf.write(stdout) ? 0 : 1;
+}
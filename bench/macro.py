@@ -0,0 +1,207 @@
+#!/usr/bin/env python3
+"""Macro-benchmark: runs the solver on the pinned corpus and reports the results as JSON.
+
+Every run of 'corpus.txt' is solved with its fixed seed and '-stats-json', and the statistics of the
+solver give the propagations/s, conflicts/s, peak memory ('memUsedPeak()') and the time spent in
+its hot paths ('notifypropagate', 'analyze', 'litRedundant', 'eliminate', ...). With '--baseline'
+the results are compared with a saved run:
+
+    make bench
+    bench/macro.py --out bench/baseline.json                  # before a change
+    bench/macro.py --baseline bench/baseline.json             # after it
+
+The exit status is 2 if an answer differs from the baseline, 1 if the geometric mean of the wall
+times regressed by more than '--threshold', and 0 otherwise. Arguments after '--' are passed to
+the solver. With '--proof' every run also writes a DRAT proof (to a temporary file, of which only
+the size is kept), so a comparison with a baseline without it gives the cost of proof logging:
+
+    bench/macro.py --proof --baseline bench/baseline.json
+"""
+
+import argparse
+import hashlib
+import json
+import math
+import os
+import subprocess
+import sys
+import tempfile
+import time
+
+HERE = os.path.dirname(os.path.abspath(__file__))
+ROOT = os.path.dirname(HERE)
+ANSWERS = {10: "SAT", 20: "UNSAT", 0: "UNKNOWN"}
+
+
+def read_corpus(path):
+    runs = []
+    with open(path) as f:
+        for n, line in enumerate(f, 1):
+            words = line.split('#', 1)[0].split()
+            if not words:
+                continue
+            if len(words) < 4 or words[2] not in ("shape", "file"):
+                sys.exit("%s:%d: expected '<name> <seed> shape|file ...'" % (path, n))
+            runs.append({"name": words[0], "seed": words[1], "kind": words[2], "args": words[3:]})
+    return runs
+
+
+def instance(run, args):
+    """The path of the problem of 'run', generating it if needed."""
+    if run["kind"] == "file":
+        return os.path.join(os.path.dirname(os.path.abspath(args.corpus)), run["args"][0])
+    os.makedirs(args.cache, exist_ok=True)
+    path = os.path.join(args.cache, "-".join(run["args"]) + ".cnf")
+    if not os.path.exists(path):
+        with open(path + ".tmp", "wb") as out:
+            subprocess.check_call([args.shapes] + run["args"], stdout=out)
+        os.replace(path + ".tmp", path)
+    return path
+
+
+def sha256(path):
+    h = hashlib.sha256()
+    with open(path, "rb") as f:
+        for block in iter(lambda: f.read(1 << 20), b""):
+            h.update(block)
+    return h.hexdigest()
+
+
+def solve(run, path, args):
+    """One run of the solver, with the statistics it wrote."""
+    fd, stats_file = tempfile.mkstemp(suffix=".json")
+    os.close(fd)
+    proof_file = None
+    if args.proof:
+        fd, proof_file = tempfile.mkstemp(suffix=args.proof)
+        os.close(fd)
+    try:
+        cmd = [args.solver, "-verb=0", "-rnd-seed=" + run["seed"], "-stats-json=" + stats_file] + args.extra
+        if proof_file:
+            cmd.append("-drat=" + proof_file)
+        cmd.append(path)
+        start = time.monotonic()
+        status = subprocess.call(cmd, stdout=subprocess.DEVNULL)
+        wall = time.monotonic() - start
+        if status not in ANSWERS:
+            sys.exit("%s: the solver failed with status %d: %s" % (run["name"], status, " ".join(cmd)))
+        with open(stats_file) as f:
+            stats = json.load(f)
+        stats["proof_bytes"] = os.path.getsize(proof_file) if proof_file else 0
+    finally:
+        os.unlink(stats_file)
+        if proof_file:
+            os.unlink(proof_file)
+    return status, wall, stats
+
+
+def measure(run, args):
+    path = instance(run, args)
+    best = None
+    for _ in range(args.repeat):
+        status, wall, stats = solve(run, path, args)
+        if best is None or wall < best[1]:
+            best = (status, wall, stats)
+    status, wall, stats = best
+    counters = stats["counters"]
+    return {
+        "seed": run["seed"],
+        "instance": " ".join(run["args"]),
+        "sha256": sha256(path),
+        "answer": ANSWERS[status],
+        "wall_seconds": wall,
+        "solver_seconds": stats["seconds"],
+        "conflicts": counters["conflicts"],
+        "propagations": counters["propagations"],
+        "decisions": counters["decisions"],
+        "conflicts_per_second": counters["conflicts"] / stats["seconds"] if stats["seconds"] > 0 else 0,
+        "propagations_per_second": counters["propagations"] / stats["seconds"] if stats["seconds"] > 0 else 0,
+        "memory_peak_mb": stats["memory_peak_mb"],
+        "proof_bytes": stats["proof_bytes"],
+        "proof_stalls": counters.get("proof_stalls", 0),
+        "timers": dict((name, t["seconds"]) for name, t in stats["timers"].items()),
+    }
+
+
+def geomean(xs):
+    return math.exp(sum(math.log(x) for x in xs) / len(xs)) if xs else 1.0
+
+
+def compare(results, baseline, threshold):
+    """Prints the ratios new/baseline, returns the exit status."""
+    status = 0
+    ratios = []
+    print("%-12s %10s %10s %7s %9s %7s  %s" % ("run", "base (s)", "new (s)", "wall", "props/s", "memory", "notes"))
+    for name, new in results["runs"].items():
+        old = baseline["runs"].get(name)
+        if old is None:
+            print("%-12s (not in the baseline)" % name)
+            continue
+        notes = []
+        if old["sha256"] != new["sha256"]:
+            notes.append("DIFFERENT INSTANCE")
+        if old["answer"] != new["answer"] and "UNKNOWN" not in (old["answer"], new["answer"]):
+            notes.append("ANSWER %s -> %s" % (old["answer"], new["answer"]))
+            status = 2
+        if old["conflicts"] != new["conflicts"]:
+            notes.append("search changed (%d -> %d conflicts)" % (old["conflicts"], new["conflicts"]))
+        wall = new["wall_seconds"] / max(old["wall_seconds"], 1e-3)
+        ratios.append(wall)
+        props = new["propagations_per_second"] / old["propagations_per_second"] if old["propagations_per_second"] > 0 else 1.0
+        memory = new["memory_peak_mb"] / old["memory_peak_mb"] if old["memory_peak_mb"] > 0 else 1.0
+        print("%-12s %10.3f %10.3f %7.3f %9.3f %7.3f  %s" % (name, old["wall_seconds"], new["wall_seconds"], wall, props, memory,
+                                                           ", ".join(notes)))
+    mean = geomean(ratios)
+    print("geometric mean of the wall time ratios: %.3f" % mean)
+    if status == 0 and mean > 1 + threshold:
+        print("REGRESSION: more than %.1f%% slower" % (threshold * 100))
+        status = 1
+    return status
+
+
+def main():
+    build = os.environ.get("BUILD_DIR", os.path.join(ROOT, "build"))
+    parser = argparse.ArgumentParser(description=__doc__.split("\n\n")[0])
+    parser.add_argument("--solver", default=os.path.join(build, "bench", "stub", "Solve"), help="(the core solver under a stub PCSolver)")
+    parser.add_argument("--shapes", default=os.path.join(build, "bench", "Shapes"))
+    parser.add_argument("--corpus", default=os.path.join(HERE, "corpus.txt"))
+    parser.add_argument("--cache", default=os.path.join(build, "bench", "corpus"), help="directory of the generated problems")
+    parser.add_argument("--repeat", type=int, default=3, help="runs per problem, the fastest counts")
+    parser.add_argument("--out", help="write the results to this file (standard output otherwise)")
+    parser.add_argument("--baseline", help="results of an earlier run to compare with")
+    parser.add_argument("--threshold", type=float, default=0.05, help="relative slow down that counts as a regression")
+    parser.add_argument("--proof", nargs="?", const=".drat", choices=[".drat", ".drat.gz"],
+                        help="also write a DRAT proof (compressed with '.drat.gz')")
+    parser.add_argument("extra", nargs="*", help="options for the solver (after '--')")
+    args = parser.parse_args()
+
+    runs = read_corpus(args.corpus)
+    results = {"solver": args.solver, "options": args.extra, "proof": args.proof, "runs": {}}
+    for run in runs:
+        results["runs"][run["name"]] = r = measure(run, args)
+        print("%-12s %-8s %8.3f s %12.0f props/s %10.0f confl/s %8.1f MB" % (run["name"], r["answer"], r["wall_seconds"],
+              r["propagations_per_second"], r["conflicts_per_second"], r["memory_peak_mb"]), file=sys.stderr)
+    done = results["runs"].values()
+    results["total"] = {
+        "wall_seconds": sum(r["wall_seconds"] for r in done),
+        "conflicts": sum(r["conflicts"] for r in done),
+        "propagations": sum(r["propagations"] for r in done),
+        "memory_peak_mb": max(r["memory_peak_mb"] for r in done) if done else 0,
+        "proof_bytes": sum(r["proof_bytes"] for r in done),
+    }
+
+    text = json.dumps(results, indent=2, sort_keys=True) + "\n"
+    if args.out:
+        with open(args.out, "w") as f:
+            f.write(text)
+    elif not args.baseline:
+        sys.stdout.write(text)
+
+    if args.baseline:
+        with open(args.baseline) as f:
+            return compare(results, json.load(f), args.threshold)
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,86 @@
+/*************************************************************************************[PCSolver.cc]
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT
+NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT
+OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+**************************************************************************************************/
+
+#include "theorysolvers/PCSolver.hpp"
+#include "external/TerminationManagement.hpp"
+#include "minisat/core/Solver.h"
+
+using namespace Minisat;
+
+namespace Minisat {
+std::ostream& operator<<(std::ostream& out, const Lit& l) {
+    return out << (sign(l) ? "-" : "") << var(l) + 1;
+}
+}
+
+namespace MinisatID {
+
+bool terminateRequested() { return false; }
+
+PCSolver::PCSolver(int verbosity) : sat(NULL), verb(verbosity), found_unsat(false) { }
+
+void PCSolver::accept(Propagator* p, EVENT e) {
+    if (e == EV_PROPAGATE && p != sat) propagators.push_back(p);
+    if (e == EV_BACKTRACK)             backtrackers.push_back(p);
+}
+
+void PCSolver::acceptFinishParsing(Propagator* p, bool late) { (void) p; (void) late; }
+
+void PCSolver::backtrackDecisionLevel(int untillevel, const Lit& decision) {
+    for (size_t i = 0; i < backtrackers.size(); i++)
+        backtrackers[i]->notifyBacktrack(untillevel, decision);
+}
+
+CRef PCSolver::createClause(const InnerDisjunction& clause, bool learnt) {
+    vec<Lit> lits;
+    for (size_t i = 0; i < clause.literals.size(); i++)
+        lits.push(clause.literals[i]);
+    return sat->makeClause(lits, learnt);
+}
+
+CRef PCSolver::getExplanation(const Lit& l) { return reasons[var(l)]->getExplanation(l); }
+
+int PCSolver::getNbOfFormulas() const { return sat != NULL ? sat->nClauses() : 0; }
+
+void PCSolver::setTrue(const Lit& l, Propagator* p, CRef explan) {
+    if ((int) reasons.size() <= var(l)) reasons.resize(sat->nVars(), NULL);
+    reasons[var(l)] = p;
+    sat->uncheckedEnqueue(l, explan);
+}
+
+// The SAT solver first, then the others in turn, until a conflict or until none of them assigns anything:
+CRef PCSolver::propagate() {
+    for (;;) {
+        CRef confl = sat->notifypropagate();
+        if (confl != CRef_Undef) return confl;
+        int before = sat->nAssigns();
+        for (size_t i = 0; i < propagators.size(); i++) {
+            confl = propagators[i]->notifypropagate();
+            if (confl != CRef_Undef) return confl;
+        }
+        if (sat->nAssigns() == before) return CRef_Undef;
+    }
+}
+
+lbool PCSolver::value(const Lit& l) const { return sat->value(l); }
+
+bool  Propagator::isTrue   (const Lit& l) const { return getPCSolver().value(l) == l_True; }
+bool  Propagator::isFalse  (const Lit& l) const { return getPCSolver().value(l) == l_False; }
+bool  Propagator::isUnknown(const Lit& l) const { return getPCSolver().value(l) == l_Undef; }
+lbool Propagator::value    (const Lit& l) const { return getPCSolver().value(l); }
+
+}
@@ -0,0 +1,94 @@
+/**********************************************************************************[SnapshotTest.cc]
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT
+NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT
+OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+**************************************************************************************************/
+
+// Test of the snapshots of 'Snapshot.cc' written above the root level: the units added during the
+// search are at level 0 above 'trail_lim[0]' (see 'injectClause()'), and they have to be root
+// literals of the snapshot, as do the pending 'rootunitlits'. Exits with 1 if anything is missing.
+//
+//   make check
+
+#include <stdio.h>
+#include <unistd.h>
+
+#include "minisat/core/Solver.h"
+#include "theorysolvers/PCSolver.hpp"
+
+using namespace Minisat;
+
+static int failures = 0;
+
+static void expect(bool good, const char* what) {
+    if (!good) {
+        printf("FAILED: %s\n", what);
+        failures++;
+    }
+}
+
+static void addClause(Solver& S, int a, int b = 0) {
+    vec<Lit> ps;
+    ps.push(mkLit(abs(a) - 1, a < 0));
+    if (b != 0) ps.push(mkLit(abs(b) - 1, b < 0));
+    S.addClause(ps);
+}
+
+static bool isTrue(Solver& S, int x) { return S.value(mkLit(abs(x) - 1, x < 0)) == l_True; }
+
+int main() {
+    char file[] = "/tmp/SnapshotTest.XXXXXX";
+    int fd = mkstemp(file);
+    if (fd < 0) {
+        printf("FAILED: no temporary file\n");
+        return 1;
+    }
+    close(fd);
+
+    {
+        MinisatID::PCSolver pcsolver;
+        Solver S(&pcsolver);
+        pcsolver.setSolver(&S);
+        for (int v = 0; v < 6; v++) S.newVar();
+        addClause(S, 1, 2);
+        addClause(S, -3, 4);
+
+        // Decide -1 (and so 2) without searching, then add the unit 3 and wait with 5:
+        vec<Lit> assumps;
+        assumps.push(mkLit(0, true));
+        S.solve(assumps, true);
+        expect(S.decisionLevel() == 1, "the assumption is decided");
+        addClause(S, 3);
+        expect(isTrue(S, 3) && S.getLevel(2) == 0, "the unit added above the root is at level 0");
+        S.rootunitlits.push_back(mkLit(4, false));
+        expect(S.writeSnapshot(file), "the snapshot is written above the root");
+    }
+
+    {
+        MinisatID::PCSolver pcsolver;
+        Solver S(&pcsolver);
+        pcsolver.setSolver(&S);
+        expect(S.readSnapshot(file), "the snapshot is read");
+        expect(S.nVars() == 6, "all variables are read");
+        expect(isTrue(S, 3), "the unit added above the root is a root literal");
+        expect(isTrue(S, 4), "what it propagates is propagated again");
+        expect(isTrue(S, 5), "the pending root unit is a root literal");
+        expect(S.value(mkLit(0)) == l_Undef && S.value(mkLit(1)) == l_Undef, "the decision and its implication are not");
+        expect(S.decisionLevel() == 0, "the snapshot is read at the root");
+    }
+
+    unlink(file);
+    if (failures == 0) printf("SnapshotTest: ok\n");
+    return failures == 0 ? 0 : 1;
+}
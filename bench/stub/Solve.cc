@@ -0,0 +1,74 @@
+/****************************************************************************************[Solve.cc]
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT
+NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT
+OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+**************************************************************************************************/
+
+// Solves a DIMACS problem with the core solver under the stub PCSolver of 'PCSolver.hpp': the
+// solver of 'bench/macro.py', as the real one only builds as part of MinisatID. Prints the answer
+// and exits with 10 (satisfiable), 20 (unsatisfiable) or 0 (interrupted), like 'minisat'. The
+// options of the solver ('-rnd-seed', '-stats-json', '-drat', ...) all apply.
+//
+//   make bench && build/bench/stub/Solve [options] file.cnf
+
+#include <signal.h>
+#include <stdio.h>
+
+#include "minisat/utils/Options.h"
+#include "minisat/utils/Stats.h"
+#include "minisat/core/Dimacs.h"
+#include "minisat/core/Solver.h"
+#include "theorysolvers/PCSolver.hpp"
+
+using namespace Minisat;
+
+static Solver* solver;
+static void SIGINT_interrupt(int) { solver->interrupt(); }
+static void SIGUSR1_stats(int) { StatsRegistry::requestDump(); }
+
+int main(int argc, char** argv) {
+    setUsageHelp("USAGE: %s [options] <input-file>\n\n  where input may be either in plain or gzipped DIMACS.\n");
+    IntOption verb         ("MAIN", "verb",          "Verbosity level (0=silent, 1=some, 2=more).", 1, IntRange(0, 2));
+    IntOption parse_threads("MAIN", "parse-threads", "Threads to parse an uncompressed input file with (0=one per core).\n", 0, IntRange(0, 256));
+    parseOptions(argc, argv, true);
+    if (argc != 2) {
+        printUsageAndExit(argc, argv);
+    }
+
+    MinisatID::PCSolver pcsolver(verb);
+    Solver S(&pcsolver);
+    pcsolver.setSolver(&S);
+    solver = &S;
+    signal(SIGINT, SIGINT_interrupt);
+    signal(SIGUSR1, SIGUSR1_stats);
+
+    parse_DIMACS(argv[1], S, parse_threads);
+    if (S.verbosity > 0) {
+        printf("|  Number of variables:  %12d                                         |\n", S.nVars());
+        printf("|  Number of clauses:    %12d                                         |\n", S.nClauses());
+    }
+    bool present;
+    S.finishParsing(present);
+
+    vec<Lit> assumps;
+    lbool ret = S.solveLimited(assumps); // (also when parsing found a conflict, it writes the statistics)
+    if (pcsolver.unsat()) {
+        ret = l_False;
+    }
+    if (S.verbosity > 0) {
+        S.printStatistics();
+    }
+    printf(ret == l_True ? "SATISFIABLE\n" : ret == l_False ? "UNSATISFIABLE\n" : "INDETERMINATE\n");
+    return ret == l_True ? 10 : ret == l_False ? 20 : 0; // (the destructor of 'S' ends the proof)
+}
@@ -0,0 +1,57 @@
+/*********************************************************************************[DPLLTmodule.hpp]
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT
+NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT
+OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+**************************************************************************************************/
+
+// Stub of the propagator interface of MinisatID (see 'bench/stub/PCSolver.hpp').
+
+#ifndef Minisat_Stub_DPLLTmodule_hpp
+#define Minisat_Stub_DPLLTmodule_hpp
+
+#include "minisat/core/SolverTypes.h"
+
+namespace MinisatID {
+
+class PCSolver;
+
+enum EVENT { EV_PROPAGATE, EV_PRINTSTATS, EV_BACKTRACK, EV_DECISIONLEVEL };
+
+class Propagator {
+public:
+    explicit Propagator(PCSolver* s) : pcsolver(s) { }
+    virtual ~Propagator() { }
+
+    PCSolver&            getPCSolver     () const { return *pcsolver; }
+
+    virtual void         notifyBacktrack (int untillevel, const Minisat::Lit& decision) { (void) untillevel; (void) decision; }
+    virtual Minisat::CRef notifypropagate() = 0;
+    virtual const char*  getName         () const = 0;
+    virtual Minisat::CRef getExplanation (const Minisat::Lit& l) = 0;
+    virtual void         finishParsing   (bool& present) = 0;
+    virtual void         printStatistics () const = 0;
+    virtual int          getNbOfFormulas () const = 0;
+
+    bool                 isTrue          (const Minisat::Lit& l) const;
+    bool                 isFalse         (const Minisat::Lit& l) const;
+    bool                 isUnknown       (const Minisat::Lit& l) const;
+    Minisat::lbool       value           (const Minisat::Lit& l) const;
+
+private:
+    PCSolver*            pcsolver;
+};
+
+}
+
+#endif
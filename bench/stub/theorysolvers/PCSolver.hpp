@@ -0,0 +1,75 @@
+/************************************************************************************[PCSolver.hpp]
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT
+NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT
+OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+**************************************************************************************************/
+
+// Stub of the PCSolver of MinisatID, just enough to build and run the solver on its own (the
+// macro-benchmark driver 'Solve.cc' and the tests of 'bench/stub/'). There is one SAT solver, the
+// other propagators (Gauss-Jordan elimination) take their turn after it until nothing changes, and
+// the callbacks for the output of MinisatID do nothing.
+
+#ifndef Minisat_Stub_PCSolver_hpp
+#define Minisat_Stub_PCSolver_hpp
+
+#include <vector>
+
+#include "modules/DPLLTmodule.hpp"
+#include "utils/Utils.hpp"
+
+namespace Minisat { class Solver; }
+
+namespace MinisatID {
+
+class PCSolver {
+public:
+    explicit PCSolver(int verbosity = 0);
+
+    void          setSolver            (Minisat::Solver* s) { sat = s; } // Once, right after its constructor.
+    bool          unsat                () const { return found_unsat; }  // Some propagator called 'notifyUnsat()'.
+
+    // Called by the solver:
+    int           verbosity            () const { return verb; }
+    void          accept               (Propagator* p, EVENT e);
+    void          acceptFinishParsing  (Propagator* p, bool late);
+    void          backtrackDecisionLevel(int untillevel, const Minisat::Lit& decision);
+    Minisat::Var  changeBranchChoice   (Minisat::Var v) { return v; }
+    Minisat::CRef checkFullAssignment  () { return Minisat::CRef_Undef; }
+    Minisat::CRef createClause         (const InnerDisjunction& clause, bool learnt);
+    Minisat::CRef getExplanation       (const Minisat::Lit& l);
+    int           getNbOfFormulas      () const;
+    void          newDecisionLevel     () { }
+    void          notifyBecameDecidable(Minisat::Var v) { (void) v; }
+    void          notifyClauseAdded    (Minisat::CRef c) { (void) c; }
+    void          notifySetTrue        (const Minisat::Lit& l) { (void) l; }
+    void          notifyUnsat          () { found_unsat = true; }
+    void          notifyVarAdded       () { }
+    void          setTrue              (const Minisat::Lit& l, Propagator* p, Minisat::CRef explan = Minisat::CRef_Undef);
+    void          printChoiceMade      (int level, const Minisat::Lit& l) { (void) level; (void) l; }
+    void          printEnqueued        (const Minisat::Lit& l) { (void) l; }
+    Minisat::CRef propagate            ();
+    Minisat::lbool value               (const Minisat::Lit& l) const;
+
+private:
+    Minisat::Solver*         sat;
+    int                      verb;
+    bool                     found_unsat;
+    std::vector<Propagator*> propagators;  // Notified of 'EV_PROPAGATE', except 'sat'.
+    std::vector<Propagator*> backtrackers; // Notified of 'EV_BACKTRACK'.
+    std::vector<Propagator*> reasons;      // The propagator that set each variable through 'setTrue()'.
+};
+
+}
+
+#endif
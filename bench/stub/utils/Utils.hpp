@@ -0,0 +1,45 @@
+/***************************************************************************************[Utils.hpp]
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT
+NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT
+OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+**************************************************************************************************/
+
+// Stub of the MinisatID utilities that the solver uses (see 'bench/stub/PCSolver.hpp').
+
+#ifndef Minisat_Stub_Utils_hpp
+#define Minisat_Stub_Utils_hpp
+
+#include <cassert>
+#include <ostream>
+#include <vector>
+
+#include "minisat/core/SolverTypes.h"
+
+#define MAssert(x) assert(x)
+
+namespace Minisat {
+std::ostream& operator<<(std::ostream& out, const Lit& l); // In DIMACS notation.
+}
+
+namespace MinisatID {
+
+inline Minisat::Lit mkPosLit(Minisat::Var v) { return Minisat::mkLit(v, false); }
+
+struct InnerDisjunction {
+    std::vector<Minisat::Lit> literals;
+};
+
+}
+
+#endif
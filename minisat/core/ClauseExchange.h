@@ -0,0 +1,127 @@
+/*******************************************************************************[ClauseExchange.h]
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT
+NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT
+OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+**************************************************************************************************/
+
+#ifndef Minisat_ClauseExchange_h
+#define Minisat_ClauseExchange_h
+
+#include <atomic>
+
+#include "minisat/mtl/IntTypes.h"
+#include "minisat/core/SolverTypes.h"
+
+namespace Minisat {
+
+//=================================================================================================
+// ClauseExchange -- bounded lock-free clause sharing between the threads of a portfolio:
+//
+// Every thread owns one ring buffer it exports to (single producer), which all other threads read
+// with their own cursor (multiple consumers). The producer never waits: when a ring is full the
+// oldest clauses are overwritten, and consumers that fell behind skip them. Each slot is guarded
+// by a sequence number (seqlock), so a consumer detects and drops slots overwritten while reading.
+
+class ClauseExchange {
+public:
+    enum { Max_Size = 8 };  // Longer clauses are not shared.
+
+    explicit ClauseExchange(int nthreads, int log2_capacity = 12)
+        : n(nthreads), mask((1 << log2_capacity) - 1), rings(new Ring[nthreads]), cursors(new uint64_t[nthreads * nthreads]) {
+        for (int i = 0; i < n; i++) {
+            rings[i].slots = new Slot[mask + 1];
+            rings[i].head.store(0, std::memory_order_relaxed);
+            for (int j = 0; j <= mask; j++)
+                rings[i].slots[j].seq.store(0, std::memory_order_relaxed); }
+        for (int i = 0; i < n * n; i++)
+            cursors[i] = 0; }
+
+    ~ClauseExchange() {
+        for (int i = 0; i < n; i++)
+            delete[] rings[i].slots;
+        delete[] rings;
+        delete[] cursors; }
+
+    int  nThreads() const { return n; }
+
+    // Publish a clause of at most 'Max_Size' literals. May only be called by thread 'from'.
+    void exportClause(int from, const Lit* lits, int size, int glue) {
+        assert(size > 0 && size <= Max_Size);
+        Ring&    r = rings[from];
+        uint64_t h = r.head.load(std::memory_order_relaxed);
+        Slot&    s = r.slots[h & mask];
+        s.seq.store(2 * h + 1, std::memory_order_relaxed);  // Odd: being written.
+        std::atomic_thread_fence(std::memory_order_release);
+        s.size.store(size, std::memory_order_relaxed);
+        s.glue.store(glue, std::memory_order_relaxed);
+        for (int i = 0; i < size; i++)
+            s.lits[i].store(toInt(lits[i]), std::memory_order_relaxed);
+        s.seq.store(2 * h + 2, std::memory_order_release);
+        r.head.store(h + 1, std::memory_order_release); }
+
+    // Calls 'add(const Lit* lits, int size, int glue)' for every clause the other threads exported
+    // since the previous call. May only be called by thread 'to'. Returns the number of clauses lost
+    // because they were overwritten before they could be read.
+    template<class AddClause>
+    int  importClauses(int to, AddClause& add) {
+        int lost = 0;
+        Lit buf[Max_Size];
+        for (int from = 0; from < n; from++) {
+            if (from == to) continue;
+            Ring&     r = rings[from];
+            uint64_t& c = cursors[to * n + from];
+            uint64_t  h = r.head.load(std::memory_order_acquire);
+            if (h - c > (uint64_t)mask + 1) {
+                lost += (int)(h - c - (mask + 1));
+                c     = h - (mask + 1); }
+            for (; c < h; c++) {
+                Slot&    s   = r.slots[c & mask];
+                uint64_t seq = s.seq.load(std::memory_order_acquire);
+                if (seq != 2 * c + 2) { lost++; continue; }
+                int size = s.size.load(std::memory_order_relaxed);
+                int glue = s.glue.load(std::memory_order_relaxed);
+                for (int i = 0; i < size; i++)
+                    buf[i] = toLit(s.lits[i].load(std::memory_order_relaxed));
+                std::atomic_thread_fence(std::memory_order_acquire);
+                if (s.seq.load(std::memory_order_relaxed) != seq) { lost++; continue; }
+                add(buf, size, glue); } }
+        return lost; }
+
+private:
+    struct Slot {
+        std::atomic<uint64_t> seq;
+        std::atomic<int>      size;
+        std::atomic<int>      glue;
+        std::atomic<int>      lits[Max_Size];
+    };
+    struct Ring {
+        Slot*                 slots;
+        std::atomic<uint64_t> head;
+        char                  pad[64];  // Keep the heads of different producers on different cache lines.
+    };
+
+    int       n;
+    int       mask;
+    Ring*     rings;
+    uint64_t* cursors;  // 'cursors[to * n + from]': next position of thread 'to' in the ring of thread 'from'.
+
+    // Not copyable:
+    ClauseExchange(const ClauseExchange&);
+    ClauseExchange& operator=(const ClauseExchange&);
+};
+
+//=================================================================================================
+}
+
+#endif
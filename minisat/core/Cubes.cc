@@ -0,0 +1,408 @@
+/***************************************************************************************[Cubes.cc]
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT
+NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT
+OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+**************************************************************************************************/
+
+#include <string.h>
+#include <algorithm>
+#include <chrono>
+#include <deque>
+#include <iostream>
+#include <mutex>
+#include <thread>
+
+#include <zlib.h>
+
+#include "minisat/utils/ParseUtils.h"
+#include "minisat/utils/WriteUtils.h"
+#include "minisat/core/ClauseExchange.h"
+#include "minisat/core/Cubes.h"
+
+using namespace Minisat;
+
+struct CubeAndConquer::Queue {
+	std::mutex lock;
+	std::deque<Cube> cubes; // The owner takes from the back, the other solvers steal from the front.
+};
+
+struct CubeAndConquer::Run {
+	std::vector<Queue> queues;
+	std::atomic<int> pending; // Cubes queued or being solved.
+	std::atomic<int> first;
+	std::vector<lbool> results;
+	std::mutex lock;
+	std::vector<std::vector<Lit> > refuted; // The final conflicts of the refuted cubes (guarded by 'lock').
+
+	explicit Run(int n) : queues(n), pending(0), first(-1), results(n, l_Undef) {}
+};
+
+//=================================================================================================
+// Constructor/Destructor:
+
+CubeAndConquer::CubeAndConquer(int log2_queue_capacity)
+		: split_depth(0), lookahead_vars(64), warmup_conflicts(1000), cube_conflicts(2000), budget_inc(1.5), log2_capacity(log2_queue_capacity), win(-1),
+			split_refuted(0), stopped(false) {}
+
+CubeAndConquer::~CubeAndConquer() {}
+
+void CubeAndConquer::addSolver(Solver* s) {
+	if (s->proofEnabled()) { // NOTE: the imported clauses cannot be derived from its own clauses
+		std::clog << "A solver of a cube-and-conquer cannot write a proof, closing it.\n";
+		s->closeProof();
+	}
+	s->drat_file = NULL;
+	s->stats_file = NULL; // NOTE: the solvers would all write the file of '-stats-json', on SIGUSR1 they write to standard error instead
+	solvers.push(s);
+	counters.push_back(Counters());
+}
+
+//=================================================================================================
+// Cubes:
+
+lbool CubeAndConquer::split(const vec<Lit>& assumps) {
+	assert(solvers.size() > 0);
+	Solver& s = *solvers[0];
+	stopped = false;
+	win = -1;
+	if (warmup_conflicts > 0) {
+		s.clearInterrupt();
+		s.setConfBudget(warmup_conflicts);
+		lbool result = s.solveLimited(assumps);
+		s.budgetOff();
+		if (result != l_Undef) {
+			win = 0;
+			return result;
+		}
+	}
+
+	int depth = split_depth;
+	if (depth <= 0) {
+		for (depth = 1; (1 << depth) < 8 * solvers.size(); depth++) {
+		}
+	}
+	size_t before = cubes.size();
+	vec<Lit> cube;
+	assumps.copyTo(cube);
+	splitCube(s, cube, depth);
+	if (!s.okay()) {
+		cubes.resize(before);
+		win = 0;
+		return l_False;
+	}
+	return cubes.size() == before ? l_False : l_Undef;
+}
+
+void CubeAndConquer::splitCube(Solver& s, vec<Lit>& cube, int depth) {
+	Lit best;
+	if (s.lookahead(cube, lookahead_vars, best) == l_False) {
+		split_refuted++;
+		return;
+	}
+	if (depth == 0 || best == lit_Undef || stopped) {
+		addCube(cube);
+		return;
+	}
+	cube.push(best);
+	splitCube(s, cube, depth - 1);
+	cube.last() = ~best;
+	splitCube(s, cube, depth - 1);
+	cube.pop();
+}
+
+void CubeAndConquer::getCube(int i, vec<Lit>& out) const {
+	out.clear();
+	for (size_t k = 0; k < cubes[i].size(); k++) {
+		out.push(cubes[i][k]);
+	}
+}
+
+void CubeAndConquer::addCube(const vec<Lit>& cube) {
+	cubes.push_back(std::vector<Lit>());
+	for (int k = 0; k < cube.size(); k++) {
+		cubes.back().push_back(cube[k]);
+	}
+}
+
+static bool putCubes(WriteBuffer& out, const std::vector<std::vector<Lit> >& cubes) {
+	for (size_t i = 0; i < cubes.size(); i++) {
+		out.put('a');
+		for (size_t k = 0; k < cubes[i].size(); k++) {
+			out.put(' ');
+			out.putInt(sign(cubes[i][k]) ? -(var(cubes[i][k]) + 1) : var(cubes[i][k]) + 1);
+		}
+		out.put(" 0\n");
+	}
+	return out.flush();
+}
+
+bool CubeAndConquer::writeCubes(const char* file) const {
+	int len = strlen(file);
+	if (len > 3 && strcmp(file + len - 3, ".gz") == 0) {
+		gzFile gz = gzopen(file, "wb");
+		if (gz == NULL) {
+			return false;
+		}
+		bool good;
+		{
+			WriteBuffer out(gz);
+			good = putCubes(out, cubes);
+		}
+		return gzclose(gz) == Z_OK && good;
+	}
+	FILE* f = fopen(file, "wb");
+	if (f == NULL) {
+		return false;
+	}
+	bool good;
+	{
+		WriteBuffer out(f);
+		good = putCubes(out, cubes);
+	}
+	return fclose(f) == 0 && good;
+}
+
+// Other lines (comments, or the "p inccnf" header and the clauses of an iCNF file) are skipped.
+bool CubeAndConquer::readCubes(const char* file) {
+	gzFile gz = gzopen(file, "rb");
+	if (gz == NULL) {
+		return false;
+	}
+	int    nvars = solvers.size() > 0 ? solvers[0]->nVars() : 0;
+	size_t first = cubes.size();
+	bool   good  = true;
+	{
+		StreamBuffer in(gz);
+		vec<Lit> cube;
+		for (;;) {
+			skipWhitespace(in);
+			if (isEof(in)) {
+				break;
+			}
+			if (*in != 'a') {
+				skipLine(in);
+				continue;
+			}
+			++in;
+			cube.clear();
+			int lit;
+			while ((good = tryParseInt(in, lit)) && lit != 0) { // (false on a malformed line, also without its 0 at the end)
+				good = abs(lit) <= nvars; // NOTE: a cube of another problem, its assumptions would be out of range
+				if (!good) {
+					break;
+				}
+				cube.push(mkLit(abs(lit) - 1, lit < 0));
+			}
+			if (!good) {
+				cubes.resize(first);
+				break;
+			}
+			addCube(cube);
+		}
+	}
+	gzclose(gz);
+	return good;
+}
+
+//=================================================================================================
+// Solving:
+
+void CubeAndConquer::interrupt() {
+	stopped = true;
+	for (int i = 0; i < solvers.size(); i++) {
+		solvers[i]->interrupt();
+	}
+}
+
+lbool CubeAndConquer::solve() {
+	int n = solvers.size();
+	win = -1;
+	stopped = false;
+	if (cubes.empty()) {
+		return l_False;
+	}
+
+	// Dealt out in turn, so that each solver starts on cubes from all over the tree:
+	Run run(n);
+	for (size_t c = 0; c < cubes.size(); c++) {
+		Cube cube;
+		cube.lits = cubes[c];
+		cube.budget = cube_conflicts;
+		run.queues[c % n].cubes.push_back(cube);
+	}
+	run.pending = cubes.size();
+
+	ClauseExchange exchange(n, log2_capacity);
+	for (int i = 0; i < n; i++) {
+		solvers[i]->clearInterrupt();
+		solvers[i]->setClauseExchange(&exchange, i);
+	}
+
+	std::vector<std::thread> threads;
+	for (int i = 0; i < n; i++) {
+		threads.push_back(std::thread([this, i, &run]() {
+			conquer(run, i);
+		}));
+	}
+	for (auto t = threads.begin(); t < threads.end(); ++t) {
+		t->join();
+	}
+
+	for (int i = 0; i < n; i++) {
+		solvers[i]->setClauseExchange(NULL, 0);
+		solvers[i]->clearInterrupt();
+		solvers[i]->budgetOff();
+	}
+
+	win = run.first.load();
+	if (win != -1) {
+		return run.results[win];
+	}
+	return run.pending.load() == 0 ? l_False : l_Undef;
+}
+
+void CubeAndConquer::conquer(Run& run, int i) {
+	Solver& s = *solvers[i];
+	Counters& count = counters[i];
+	size_t imported = 0;
+	vec<Lit> assumps;
+	Cube cube;
+	while (run.first.load() == -1 && not stopped && run.pending.load() > 0) {
+		if (!take(run, i, cube)) {
+			std::this_thread::sleep_for(std::chrono::microseconds(500)); // (the cubes being solved may still be split again)
+			continue;
+		}
+
+		bool pruned = importRefuted(run, i, imported, cube);
+		if (!s.okay()) {
+			finish(run, i, l_False);
+		} else if (pruned) {
+			count.pruned++;
+		} else {
+			assumps.clear();
+			for (size_t k = 0; k < cube.lits.size(); k++) {
+				assumps.push(cube.lits[k]);
+			}
+			count.solved++;
+			s.setConfBudget(cube.budget);
+			lbool result = s.solveLimited(assumps);
+			if (result == l_True || (result == l_False && s.conflict.size() == 0)) {
+				finish(run, i, result);
+			} else if (result == l_False) {
+				count.refuted++;
+				std::vector<Lit> clause;
+				for (int k = 0; k < s.conflict.size(); k++) {
+					clause.push_back(s.conflict[k]);
+				}
+				std::lock_guard<std::mutex> guard(run.lock);
+				run.refuted.push_back(clause);
+			} else if (run.first.load() == -1 && not stopped) {
+				// Out of budget, split again (or try again with a larger budget if there is no variable left to split on):
+				Lit best;
+				count.resplit++;
+				if (s.lookahead(assumps, lookahead_vars, best) == l_False) {
+					count.refuted++;
+					std::vector<Lit> clause; // (the negation of the cube, as there is no final conflict)
+					for (size_t k = 0; k < cube.lits.size(); k++) {
+						clause.push_back(~cube.lits[k]);
+					}
+					std::lock_guard<std::mutex> guard(run.lock);
+					run.refuted.push_back(clause);
+				} else {
+					Cube child;
+					child.lits = cube.lits;
+					child.budget = (int64_t) (cube.budget * budget_inc);
+					std::lock_guard<std::mutex> guard(run.queues[i].lock);
+					if (best != lit_Undef) {
+						child.lits.push_back(~best);
+						run.queues[i].cubes.push_back(child);
+						run.pending++;
+						child.lits.back() = best;
+					}
+					run.queues[i].cubes.push_back(child); // (taken first)
+					run.pending++;
+				}
+			}
+		}
+		run.pending--;
+	}
+}
+
+bool CubeAndConquer::take(Run& run, int i, Cube& cube) {
+	int n = solvers.size();
+	for (int k = 0; k < n; k++) {
+		Queue& q = run.queues[(i + k) % n];
+		std::lock_guard<std::mutex> guard(q.lock);
+		if (q.cubes.empty()) {
+			continue;
+		}
+		if (k == 0) {
+			cube = q.cubes.back();
+			q.cubes.pop_back();
+		} else {
+			cube = q.cubes.front();
+			q.cubes.pop_front();
+			counters[i].stolen++;
+		}
+		return true;
+	}
+	return false;
+}
+
+// The clauses are added outside of search, where the trail kept since the last cube may falsify them: see
+// 'Solver::injectClause()'.
+bool CubeAndConquer::importRefuted(Run& run, int i, size_t& imported, const Cube& cube) {
+	Solver& s = *solvers[i];
+	std::lock_guard<std::mutex> guard(run.lock);
+	vec<Lit> clause;
+	for (; imported < run.refuted.size() && s.okay(); imported++) {
+		clause.clear();
+		for (size_t k = 0; k < run.refuted[imported].size(); k++) {
+			clause.push(run.refuted[imported][k]);
+		}
+		s.addClause(clause);
+	}
+	for (size_t c = 0; c < run.refuted.size(); c++) {
+		const std::vector<Lit>& r = run.refuted[c];
+		bool falsified = true;
+		for (size_t k = 0; k < r.size() && falsified; k++) {
+			falsified = std::find(cube.lits.begin(), cube.lits.end(), ~r[k]) != cube.lits.end();
+		}
+		if (falsified) {
+			return true;
+		}
+	}
+	return false;
+}
+
+void CubeAndConquer::finish(Run& run, int i, lbool result) {
+	int none = -1;
+	if (run.first.compare_exchange_strong(none, i)) {
+		run.results[i] = result;
+		for (int k = 0; k < solvers.size(); k++) {
+			solvers[k]->interrupt();
+		}
+	}
+}
+
+void CubeAndConquer::printStatistics() const {
+	std::clog << "> cubes: " << cubes.size() << " (" << split_refuted << " more refuted by the lookahead)\n";
+	for (int i = 0; i < solvers.size(); i++) {
+		const Solver& s = *solvers[i];
+		const Counters& c = counters[i];
+		std::clog << "> solver " << i << (i == win ? " (winner)" : "") << ": " << c.solved << " cubes solved, " << c.refuted << " refuted, " << c.pruned
+				<< " pruned, " << c.resplit << " split again, " << c.stolen << " stolen, " << s.conflicts << " conflicts, " << s.shared_exported
+				<< " exported, " << s.shared_imported << " imported\n";
+	}
+}
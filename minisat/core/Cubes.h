@@ -0,0 +1,110 @@
+/****************************************************************************************[Cubes.h]
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT
+NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT
+OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+**************************************************************************************************/
+
+#ifndef Minisat_Cubes_h
+#define Minisat_Cubes_h
+
+#include <atomic>
+#include <vector>
+
+#include "minisat/core/Solver.h"
+
+namespace Minisat {
+
+//=================================================================================================
+// CubeAndConquer -- splits a problem into cubes by lookahead, and solves the cubes in parallel:
+//
+// 'split()' has solver 0 search for a little while (for the activities of the lookahead), then
+// splits the problem with 'Solver::lookahead()' into cubes of 'split_depth' literals. 'solve()'
+// deals the cubes out to the solvers, one thread each, which solve them as assumptions with a
+// budget of conflicts. A solver takes the newest cube of its own queue, or steals the oldest one
+// of another queue. A cube that exhausts its budget is split again into two cubes with a larger
+// budget. The final 'conflict' of a refuted cube is a clause over the literals of the cube that
+// follows from the problem: it is added to all solvers, which also drop the queued cubes it
+// falsifies. Meanwhile the solvers share short learnt clauses through a 'ClauseExchange'.
+//
+// As in a 'Portfolio', the solvers are created (and given the problem) by the caller. The cubes
+// can also be written to a file (and read back) to solve them elsewhere.
+
+class CubeAndConquer {
+public:
+    explicit CubeAndConquer(int log2_queue_capacity = 12);
+    ~CubeAndConquer();
+
+    void    addSolver      (Solver* s);
+    int     nSolvers       ()      const { return solvers.size(); }
+    Solver& getSolver      (int i) const { return *solvers[i]; }
+
+    // Cubes:
+    lbool   split          (const vec<Lit>& assumps);           // With solver 0, the cubes extend 'assumps'. l_True or l_False if that gave the answer already.
+    int     nCubes         ()      const { return cubes.size(); }
+    void    getCube        (int i, vec<Lit>& out) const;
+    void    addCube        (const vec<Lit>& cube);
+    void    clearCubes     ()            { cubes.clear(); }
+    bool    writeCubes     (const char* file) const;            // One "a <literals> 0" line per cube (as march_cu), compressed if 'file' ends in ".gz". False if it cannot be written.
+    bool    readCubes      (const char* file);                  // Adds the cubes of such a file. False, adding none, if it cannot be opened, has a malformed cube or a variable the solvers do not have.
+
+    // Solving:
+    lbool   solve          ();                                  // l_True if a cube has a model, l_False if all cubes are refuted (also if there are none), l_Undef if interrupted.
+    int     winner         ()      const { return win; }        // Index of the solver with the model (or the refutation without assumptions) of the last 'solve()', or -1.
+    void    interrupt      ();                                  // Stop all solvers (asynchronously).
+
+    void    printStatistics() const;
+
+    // Mode of operation:
+    //
+    int     split_depth;        // Literals added to the assumptions per cube by 'split()', 0 for enough cubes to give each solver 8.   (default 0)
+    int     lookahead_vars;     // The number of most active variables probed by a lookahead.                                               (default 64)
+    int     warmup_conflicts;   // Conflicts of solver 0 before 'split()' looks ahead.                                                      (default 1000)
+    int     cube_conflicts;     // The initial conflict budget of a cube.                                                                   (default 2000)
+    double  budget_inc;         // The factor with which the budget is multiplied for the cubes of a cube split again.                      (default 1.5)
+
+protected:
+    struct Cube {
+        std::vector<Lit> lits;
+        int64_t          budget;
+    };
+    struct Queue;
+    struct Run;                 // The state shared by the threads of a 'solve()'.
+    struct Counters {
+        uint64_t solved, refuted, pruned, resplit, stolen;
+        Counters() : solved(0), refuted(0), pruned(0), resplit(0), stolen(0) {}
+    };
+
+    vec<Solver*>                   solvers;
+    std::vector<Counters>          counters;     // Per solver, written by its thread only.
+    std::vector<std::vector<Lit> > cubes;
+    int                            log2_capacity;
+    int                            win;
+    int                            split_refuted;
+    std::atomic<bool>              stopped;
+
+    void    splitCube      (Solver& s, vec<Lit>& cube, int depth);
+    void    conquer        (Run& run, int i);                   // The thread of solver 'i'.
+    bool    take           (Run& run, int i, Cube& cube);
+    bool    importRefuted  (Run& run, int i, size_t& imported, const Cube& cube); // True if 'cube' falsifies one of the clauses of refuted cubes.
+    void    finish         (Run& run, int i, lbool result);
+
+    // Not copyable:
+    CubeAndConquer(const CubeAndConquer&);
+    CubeAndConquer& operator=(const CubeAndConquer&);
+};
+
+//=================================================================================================
+}
+
+#endif
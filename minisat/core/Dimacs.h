@@ -22,6 +22,12 @@ OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWA
 #define Minisat_Dimacs_h
 
 #include <stdio.h>
+/*AB*/
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+/*AE*/
 
 #include "minisat/utils/ParseUtils.h"
 #include "minisat/core/SolverTypes.h"
@@ -83,6 +89,196 @@ static void parse_DIMACS(gzFile input_stream, Solver& S) {
     StreamBuffer in(input_stream);
     parse_DIMACS_main(in, S); }
 
+/*AB*/
+//=================================================================================================
+// Parallel DIMACS parser for uncompressed files:
+//
+// The mapped file is split in chunks at line starts. A pool of threads parses the chunks into flat
+// literal streams ('0' ends a clause, so a clause may continue in the next chunk), which the calling
+// thread adds to the solver in order. Only a window of chunks is parsed ahead of it, which bounds
+// the memory used for the streams.
+
+struct DimacsChunk {
+    const char*      begin;
+    const char*      end;
+    std::vector<int> lits;
+    int              max_var;
+    int              clauses;
+    const char*      error;     // Position of a parse error, or NULL.
+    bool             ready;
+
+    DimacsChunk(const char* b, const char* e) : begin(b), end(e), max_var(0), clauses(0), error(NULL), ready(false) {}
+};
+
+static inline void parseDimacsChunk(DimacsChunk& c) {
+    const char* p          = c.begin;
+    const char* end        = c.end;
+    bool        line_start = true;
+    c.lits.reserve((end - p) / 4);
+    while (p < end){
+        char ch = *p;
+        if (ch == '\n') { line_start = true; p++; continue; }
+        if ((ch >= 9 && ch <= 13) || ch == 32) { p++; continue; }
+        if (ch == 'c' || (line_start && ch == 'p')){ // (the header was read before splitting)
+            const char* nl = (const char*)memchr(p, '\n', end - p);
+            p = nl == NULL ? end : nl;
+            continue; }
+        line_start = false;
+
+        bool neg = false;
+        if      (ch == '-') neg = true, p++;
+        else if (ch == '+') p++;
+        uint32_t    v;
+        const char* q = scanUnsigned(p, end, v);
+        if (q == p) { c.error = p; return; }
+        p = q;
+        if (v == 0) c.clauses++;
+        else if ((int)v > c.max_var) c.max_var = v;
+        c.lits.push_back(neg ? -(int)v : (int)v);
+    }
+}
+
+// Returns false if 'path' is not an uncompressed regular file that can be mapped:
+template<class Solver>
+static bool parse_DIMACS_mapped(const char* path, Solver& S, int threads) {
+    MappedFile f(path);
+    if (f.data == NULL || (f.size >= 2 && (unsigned char)f.data[0] == 0x1f && (unsigned char)f.data[1] == 0x8b))
+        return false;
+    const char* end = f.data + f.size;
+
+    // Header:
+    int vars    = 0;
+    int clauses = 0;
+    for (const char* p = f.data; p < end;){
+        if ((*p >= 9 && *p <= 13) || *p == 32) { p++; continue; }
+        if (*p == 'c'){
+            const char* nl = (const char*)memchr(p, '\n', end - p);
+            p = nl == NULL ? end : nl;
+            continue; }
+        if (*p == 'p'){
+            uint32_t v = 0, c = 0;
+            if (end - p < 5 || strncmp(p, "p cnf", 5) != 0)
+                printf("PARSE ERROR! Unexpected char: %c\n", *p), exit(3);
+            for (p += 5; p < end && (*p == ' ' || *p == '\t'); p++);
+            p = scanUnsigned(p, end, v);
+            for (; p < end && (*p == ' ' || *p == '\t'); p++);
+            scanUnsigned(p, end, c);
+            vars    = v;
+            clauses = c; }
+        break; }
+
+    // Chunks:
+    const uint64_t           chunk_size = 8 << 20;
+    std::vector<DimacsChunk> chunks;
+    for (const char* b = f.data; b < end;){
+        const char* e = (uint64_t)(end - b) > chunk_size ? b + chunk_size : end;
+        if (e < end){
+            const char* nl = (const char*)memchr(e, '\n', end - e);
+            e = nl == NULL ? end : nl + 1; }
+        chunks.push_back(DimacsChunk(b, e));
+        b = e; }
+
+    if (threads <= 0) threads = std::thread::hardware_concurrency();
+    if (threads <= 0) threads = 1;
+    if ((size_t)threads > chunks.size()) threads = chunks.size();
+
+    std::mutex               mtx;
+    std::condition_variable  cv;
+    size_t                   next     = 0;
+    size_t                   consumed = 0;
+    bool                     stop     = false;
+    const size_t             window   = 2 * threads;
+    std::vector<std::thread> pool;
+    auto work = [&]() {
+        for (;;){
+            size_t k;
+            {
+                std::unique_lock<std::mutex> lock(mtx);
+                cv.wait(lock, [&]{ return stop || next >= chunks.size() || next < consumed + window; });
+                if (stop || next >= chunks.size()) return;
+                k = next++;
+            }
+            parseDimacsChunk(chunks[k]);
+            {
+                std::lock_guard<std::mutex> lock(mtx);
+                chunks[k].ready = true;
+            }
+            cv.notify_all(); } };
+    if (threads > 1)
+        for (int t = 0; t < threads; t++)
+            pool.push_back(std::thread(work));
+
+    // Add the clauses in order:
+    vec<Lit>    lits;
+    int         cnt   = 0;
+    const char* error = NULL;
+    for (size_t k = 0; k < chunks.size(); k++){
+        DimacsChunk& c = chunks[k];
+        if (pool.empty())
+            parseDimacsChunk(c);
+        else {
+            std::unique_lock<std::mutex> lock(mtx);
+            cv.wait(lock, [&]{ return c.ready; }); }
+        if (c.error != NULL) { error = c.error; break; }
+
+        if (k == 0){
+            // The first chunk gives the number of literals per byte:
+            uint64_t nlits = c.lits.size() - c.clauses;
+            S.reserve(vars > c.max_var ? vars : c.max_var, clauses, (uint64_t)(nlits * (double)f.size / (c.end - c.begin))); }
+        while (c.max_var > S.nVars()) S.newVar();
+        for (size_t i = 0; i < c.lits.size(); i++){
+            int l = c.lits[i];
+            if (l == 0){
+                cnt++;
+                S.addClause_(lits);
+                lits.clear();
+            }else
+                lits.push(l > 0 ? mkLit(l - 1) : ~mkLit(-l - 1)); }
+        std::vector<int>().swap(c.lits);
+
+        if (!pool.empty()){
+            {
+                std::lock_guard<std::mutex> lock(mtx);
+                consumed = k + 1;
+            }
+            cv.notify_all(); } }
+
+    {
+        std::lock_guard<std::mutex> lock(mtx);
+        stop = true;
+    }
+    cv.notify_all();
+    for (size_t t = 0; t < pool.size(); t++)
+        pool[t].join();
+
+    if (error != NULL)
+        fprintf(stderr, "PARSE ERROR! Unexpected char: %c\n", *error), exit(3);
+    if (lits.size() > 0)
+        fprintf(stderr, "PARSE ERROR! Unexpected end of file inside a clause\n"), exit(3);
+    if (vars != S.nVars())
+        fprintf(stderr, "WARNING! DIMACS header mismatch: wrong number of variables.\n");
+    if (cnt  != clauses)
+        fprintf(stderr, "WARNING! DIMACS header mismatch: wrong number of clauses.\n");
+    return true;
+}
+
+// Inserts the problem in file 'path' into solver. Uncompressed files are mapped and parsed by
+// 'threads' threads (0 = one per core), gzipped ones are decompressed in a separate thread.
+//
+template<class Solver>
+static void parse_DIMACS(const char* path, Solver& S, int threads = 0) {
+    if (parse_DIMACS_mapped(path, S, threads))
+        return;
+    gzFile input_stream = gzopen(path, "rb");
+    if (input_stream == NULL)
+        printf("ERROR! Could not open file: %s\n", path), exit(1);
+    {
+        ThreadedStreamBuffer in(input_stream);
+        parse_DIMACS_main(in, S);
+    }
+    gzclose(input_stream); }
+/*AE*/
+
 //=================================================================================================
 }
 
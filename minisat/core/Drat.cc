@@ -0,0 +1,103 @@
+/****************************************************************************************[Drat.cc]
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT
+NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT
+OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+**************************************************************************************************/
+
+#include <stdio.h>
+#include <string.h>
+#include <chrono>
+
+#include "minisat/mtl/XAlloc.h"
+#include "minisat/core/Drat.h"
+
+using namespace Minisat;
+
+DratWriter::DratWriter()
+    : records(0), stalls(0), ring(NULL), mask(0), pos(0), head(0), tail(0), closing(false), failed(false), file(NULL), gz(NULL) {}
+
+DratWriter::~DratWriter() { close(); }
+
+bool DratWriter::open(const char* name, int log2_capacity)
+{
+    close();
+    size_t len = strlen(name);
+    if (len > 3 && strcmp(name + len - 3, ".gz") == 0){
+        gz = gzopen(name, "wb1"); // (the writer thread compresses, fast is good enough)
+        if (gz == NULL) return false;
+    }else{
+        file = fopen(name, "wb");
+        if (file == NULL) return false;
+        setvbuf(file, NULL, _IONBF, 0); } // (the ring is the buffer)
+
+    ring    = (char*)xrealloc(NULL, (size_t)1 << log2_capacity);
+    mask    = ((uint64_t)1 << log2_capacity) - 1;
+    pos     = 0;
+    records = stalls = 0;
+    head.store(0, std::memory_order_relaxed);
+    tail.store(0, std::memory_order_relaxed);
+    closing.store(false, std::memory_order_relaxed);
+    failed.store(false, std::memory_order_relaxed);
+    writer  = std::thread(&DratWriter::drain, this);
+    return true;
+}
+
+bool DratWriter::close()
+{
+    if (ring == NULL) return true;
+    closing.store(true, std::memory_order_release);
+    writer.join();
+    bool good = !failed.load(std::memory_order_relaxed);
+    if (file != NULL) good = fclose(file) == 0 && good;
+    if (gz   != NULL) good = gzclose(gz) == Z_OK && good;
+    file = NULL;
+    gz   = NULL;
+    free(ring);
+    ring = NULL;
+    return good;
+}
+
+void DratWriter::room(uint64_t bytes)
+{
+    assert(bytes <= mask + 1);
+    if (pos + bytes - tail.load(std::memory_order_acquire) <= mask + 1)
+        return;
+    stalls++;
+    head.store(pos, std::memory_order_release);
+    while (pos + bytes - tail.load(std::memory_order_acquire) > mask + 1)
+        std::this_thread::yield();
+}
+
+void DratWriter::drain()
+{
+    for (;;){
+        bool     last = closing.load(std::memory_order_acquire); // (read before 'head', so nothing published before closing is missed)
+        uint64_t h    = head.load(std::memory_order_acquire);
+        uint64_t t    = tail.load(std::memory_order_relaxed);
+        if (h == t){
+            if (last) return;
+            std::this_thread::sleep_for(std::chrono::microseconds(500));
+            continue; }
+
+        // At most two pieces, at the end and at the start of the ring:
+        while (t < h){
+            uint64_t from = t & mask;
+            uint64_t n    = h - t < mask + 1 - from ? h - t : mask + 1 - from;
+            if (!failed.load(std::memory_order_relaxed)){ // (after a failure the proof is only consumed, so the solver never waits for it)
+                bool good = file != NULL ? fwrite(ring + from, 1, n, file) == n : gzwrite(gz, ring + from, (unsigned)n) == (int)n;
+                if (!good) failed.store(true, std::memory_order_relaxed); }
+            t += n; }
+        tail.store(t, std::memory_order_release);
+    }
+}
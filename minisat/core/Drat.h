@@ -0,0 +1,107 @@
+/*****************************************************************************************[Drat.h]
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT
+NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT
+OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+**************************************************************************************************/
+
+#ifndef Minisat_Drat_h
+#define Minisat_Drat_h
+
+#include <atomic>
+#include <thread>
+
+#include <zlib.h>
+
+#include "minisat/mtl/IntTypes.h"
+#include "minisat/mtl/Vec.h"
+#include "minisat/core/SolverTypes.h"
+
+namespace Minisat {
+
+//=================================================================================================
+// DratWriter -- a binary DRAT proof, written by a background thread:
+//
+// Every addition ('a') or deletion ('d') is encoded directly into a ring buffer: the literals as
+// variable length integers ('2 * (var + 1) + sign', 7 bits per byte) and a terminating 0. The
+// solving thread is the only producer and only publishes its position with a release store; the
+// writer thread is the only consumer and hands what was published to 'fwrite()' or, for a file
+// name ending in ".gz", to 'gzwrite()'. The producer waits only when the writer is a whole ring
+// behind ('stalls' counts how often).
+//
+// The proof is relative to the clauses given to the solver, so it can be checked against the
+// problem only if all clauses came from it: explanations of other propagators (including the
+// Gauss-Jordan propagator) and clauses imported from a portfolio are not derivable in DRAT.
+
+class DratWriter {
+public:
+    DratWriter();
+    ~DratWriter();                          // (closes)
+
+    bool     open    (const char* file, int log2_capacity = 24); // False if the file cannot be created.
+    bool     close   ();                    // False if anything could not be written.
+    bool     isOpen  ()  const { return ring != NULL; }
+
+    // 'extra' (if not 'lit_Undef') is one more literal of the clause, e.g. the one removed by strengthening:
+    template<class Lits>
+    void     add     (const Lits& c, Lit extra = lit_Undef) { record('a', c, extra); }
+    template<class Lits>
+    void     remove  (const Lits& c, Lit extra = lit_Undef) { record('d', c, extra); }
+    void     add     (Lit unit)             { vec<Lit> none; record('a', none, unit); }
+
+    // Statistics: (read-only member variable)
+    //
+    uint64_t records, stalls;
+
+protected:
+    char*                 ring;
+    uint64_t              mask;
+    uint64_t              pos;              // Where the producer writes next (published as 'head').
+    std::atomic<uint64_t> head;             // Written by the producer,
+    std::atomic<uint64_t> tail;             // by the writer thread.
+    std::atomic<bool>     closing;
+    std::atomic<bool>     failed;
+    FILE*                 file;
+    gzFile                gz;
+    std::thread           writer;
+
+    void     drain   ();                   // The writer thread.
+    void     room    (uint64_t bytes);     // Wait until 'bytes' more fit in the ring.
+
+    void     put     (char c) { ring[pos++ & mask] = c; }
+    void     putLit  (Lit p)  {
+        uint32_t u = toInt(p) + 2;
+        while (u > 127){ put((char)(0x80 | (u & 127))); u >>= 7; }
+        put((char)u); }
+
+    template<class Lits>
+    void     record  (char kind, const Lits& c, Lit extra) {
+        room(2 + 5 * (uint64_t)(c.size() + 1));
+        put(kind);
+        for (int i = 0; i < c.size(); i++)
+            putLit(c[i]);
+        if (extra != lit_Undef)
+            putLit(extra);
+        put(0);
+        records++;
+        head.store(pos, std::memory_order_release); }
+
+    // Not copyable:
+    DratWriter(const DratWriter&);
+    DratWriter& operator=(const DratWriter&);
+};
+
+//=================================================================================================
+}
+
+#endif
@@ -0,0 +1,333 @@
+/***************************************************************************************[Gauss.cc]
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT
+NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT
+OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+**************************************************************************************************/
+
+#include <iostream>
+
+#include "minisat/core/Gauss.h"
+
+#include "utils/Utils.hpp"
+#include "theorysolvers/PCSolver.hpp"
+
+using namespace Minisat;
+using namespace MinisatID;
+
+//=================================================================================================
+// Constructor/Destructor:
+
+GaussPropagator::GaussPropagator(PCSolver* s, Solver& sat, const std::vector<Xor>& xors)
+		: Propagator(s), propagations(0), conflicts(0), pivot_swaps(0), pauses(0), solver(sat), head(sat.newTrailHead()), nrows(0),
+			ncols(0), words(0), unsat(false), calls(0), pause(Unproductive), paused_until(0), total_calls(0) {
+	varcol.growTo(solver.nVars(), -1);
+	for (auto x = xors.cbegin(); x < xors.cend(); ++x) {
+		for (auto v = x->vars.cbegin(); v < x->vars.cend(); ++v) {
+			if (varcol[*v] == -1) {
+				varcol[*v] = ncols++;
+				colvar.push(*v);
+			}
+		}
+	}
+	nrows = xors.size();
+	words = (ncols + 63) / 64;
+	matrix.growTo(nrows * words, 0);
+	for (int r = 0; r < nrows; r++) {
+		const Xor& x = xors[r];
+		for (auto v = x.vars.cbegin(); v < x.vars.cend(); ++v) {
+			row(r)[varcol[*v] >> 6] ^= (uint64_t) 1 << (varcol[*v] & 63); // (a variable that occurs twice cancels out)
+		}
+		rhs.push(x.rhs);
+	}
+	eliminate();
+
+	assigned.growTo(words, 0);
+	values.growTo(words, 0);
+	touched.growTo(nrows, 0);
+	reasons.growTo(ncols * words, 0);
+	touchAll();
+
+	getPCSolver().accept(this, EV_PROPAGATE);
+	getPCSolver().accept(this, EV_BACKTRACK);
+	getPCSolver().accept(this, EV_PRINTSTATS);
+	if (unsat) {
+		getPCSolver().notifyUnsat();
+	}
+}
+
+GaussPropagator::~GaussPropagator() {
+}
+
+//=================================================================================================
+// Matrix operations:
+
+void GaussPropagator::addRow(int to, int from) {
+	uint64_t* t = row(to);
+	const uint64_t* f = row(from);
+	for (int w = 0; w < words; w++) {
+		t[w] ^= f[w];
+	}
+	rhs[to] ^= rhs[from];
+}
+
+void GaussPropagator::swapRows(int a, int b) {
+	uint64_t* ra = row(a);
+	uint64_t* rb = row(b);
+	for (int w = 0; w < words; w++) {
+		uint64_t tmp = ra[w];
+		ra[w] = rb[w];
+		rb[w] = tmp;
+	}
+	char tmp = rhs[a];
+	rhs[a] = rhs[b];
+	rhs[b] = tmp;
+}
+
+void GaussPropagator::eliminate() {
+	pivotrow.growTo(ncols, -1);
+	int rank = 0;
+	for (int c = 0; c < ncols && rank < nrows; c++) {
+		int r = rank;
+		while (r < nrows && !has(row(r), c)) {
+			r++;
+		}
+		if (r == nrows) {
+			continue;
+		}
+		swapRows(rank, r);
+		for (int i = 0; i < nrows; i++) {
+			if (i != rank && has(row(i), c)) {
+				addRow(i, rank);
+			}
+		}
+		pivot.push(c);
+		pivotrow[c] = rank;
+		rank++;
+	}
+
+	// The remaining rows are empty: '0 = 0' can be dropped, '0 = 1' is a contradiction.
+	for (int r = rank; r < nrows; r++) {
+		if (rhs[r]) {
+			unsat = true;
+		}
+	}
+	nrows = rank;
+	matrix.shrink(matrix.size() - nrows * words);
+	rhs.shrink(rhs.size() - nrows);
+}
+
+void GaussPropagator::touch(int r) {
+	if (!touched[r]) {
+		touched[r] = 1;
+		touched_rows.push(r);
+	}
+}
+
+void GaussPropagator::touchAll() {
+	for (int r = 0; r < nrows; r++) {
+		touch(r);
+	}
+}
+
+// Replace the assigned pivot of row 'r' by an unassigned column of the row, and eliminate that column from the other rows:
+void GaussPropagator::repivot(int r) {
+	const uint64_t* bits = row(r);
+	int nc = -1;
+	for (int w = 0; w < words && nc == -1; w++) {
+		uint64_t free = bits[w] & ~assigned[w];
+		if (free != 0) {
+			nc = w * 64 + __builtin_ctzll(free);
+		}
+	}
+	if (nc == -1) {
+		return;
+	}
+	pivotrow[pivot[r]] = -1;
+	pivot[r] = nc;
+	pivotrow[nc] = r;
+	pivot_swaps++;
+	for (int i = 0; i < nrows; i++) {
+		if (i != r && has(row(i), nc)) {
+			addRow(i, r);
+			touch(i);
+		}
+	}
+}
+
+void GaussPropagator::assign(Lit p) {
+	int c = var(p) < varcol.size() ? varcol[var(p)] : -1;
+	if (c == -1 || has(&assigned[0], c)) { // (literals kept by chronological backtracking are seen again)
+		return;
+	}
+	set(&assigned[0], c);
+	if (!sign(p)) {
+		set(&values[0], c);
+	}
+	assigned_cols.push(c);
+	if (solver.decisionLevel() > 0 && paused_until > total_calls) {
+		return; // (the rows are touched again when the pause ends)
+	}
+
+	if (pivotrow[c] >= 0) {
+		repivot(pivotrow[c]);
+	}
+	for (int i = 0; i < nrows; i++) {
+		if (has(row(i), c)) {
+			touch(i);
+		}
+	}
+}
+
+//=================================================================================================
+// Propagation:
+
+CRef GaussPropagator::makeClause(const uint64_t* bits, Lit implied) const {
+	InnerDisjunction d;
+	if (implied != lit_Undef) {
+		d.literals.push_back(implied);
+	}
+	for (int w = 0; w < words; w++) {
+		for (uint64_t b = bits[w]; b != 0; b &= b - 1) {
+			Var v = colvar[w * 64 + __builtin_ctzll(b)];
+			if (implied == lit_Undef || v != var(implied)) {
+				assert(solver.value(v) != l_Undef);
+				d.literals.push_back(mkLit(v, solver.value(v) == l_True));
+			}
+		}
+	}
+	return getPCSolver().createClause(d, true);
+}
+
+CRef GaussPropagator::checkRow(int r) {
+	const uint64_t* bits = row(r);
+	int nfree = 0, free = -1;
+	bool parity = rhs[r];
+	for (int w = 0; w < words && nfree < 2; w++) {
+		uint64_t f = bits[w] & ~assigned[w];
+		nfree += __builtin_popcountll(f);
+		if (f != 0) {
+			free = w * 64 + __builtin_ctzll(f);
+		}
+		parity ^= __builtin_parityll(bits[w] & values[w]);
+	}
+	if (nfree >= 2) {
+		return CRef_Undef;
+	}
+	if (nfree == 0) {
+		if (!parity) {
+			return CRef_Undef;
+		}
+		conflicts++;
+		return makeClause(bits, lit_Undef);
+	}
+
+	// The free column must take the remaining parity:
+	Lit p = mkLit(colvar[free], !parity);
+	if (solver.value(p) == l_True) {
+		return CRef_Undef;
+	}
+	if (solver.value(p) == l_False) { // (assigned, but not read from the trail yet)
+		conflicts++;
+		return makeClause(bits, lit_Undef);
+	}
+	uint64_t* reason = &reasons[free * words];
+	for (int w = 0; w < words; w++) {
+		reason[w] = bits[w];
+	}
+	propagations++;
+	getPCSolver().setTrue(p, this);
+	return CRef_Undef;
+}
+
+CRef GaussPropagator::notifypropagate() {
+	total_calls++;
+	for (;;) {
+		const Lit* lits;
+		int n = solver.trailSlice(head, lits);
+		for (int i = 0; i < n; i++) {
+			assign(lits[i]);
+		}
+
+		if (paused_until > total_calls && solver.decisionLevel() > 0) {
+			return CRef_Undef;
+		}
+		if (paused_until == total_calls) {
+			for (int r = 0; r < nrows; r++) {
+				if (has(&assigned[0], pivot[r])) {
+					repivot(r);
+				}
+			}
+			touchAll();
+		}
+		if (touched_rows.size() == 0) {
+			return CRef_Undef;
+		}
+
+		uint64_t before = propagations + conflicts;
+		CRef confl = CRef_Undef;
+		int i;
+		for (i = 0; i < touched_rows.size() && confl == CRef_Undef; i++) {
+			touched[touched_rows[i]] = 0;
+			confl = checkRow(touched_rows[i]);
+		}
+		// NOTE: after a conflict, the rows not checked yet stay touched
+		for (int j = i; j < touched_rows.size(); j++) {
+			touched_rows[j - i] = touched_rows[j];
+		}
+		touched_rows.shrink(i);
+		if (confl != CRef_Undef) {
+			calls = 0;
+			return confl;
+		}
+
+		if (propagations + conflicts > before) {
+			calls = 0;
+			pause = Unproductive;
+		} else {
+			if (++calls >= (uint64_t) Unproductive) {
+				// Back off, for twice as long as the previous time if that pause did not help:
+				calls = 0;
+				pauses++;
+				paused_until = total_calls + pause;
+				pause *= 2;
+			}
+			return CRef_Undef;
+		}
+	}
+}
+
+CRef GaussPropagator::getExplanation(const Lit& l) {
+	assert(varcol[var(l)] != -1);
+	return makeClause(&reasons[varcol[var(l)] * words], l);
+}
+
+void GaussPropagator::notifyBacktrack(int untillevel, const Lit& decision) {
+	int i, j;
+	for (i = j = 0; i < assigned_cols.size(); i++) {
+		int c = assigned_cols[i];
+		if (solver.value(colvar[c]) == l_Undef) {
+			clear(&assigned[0], c);
+			clear(&values[0], c);
+		} else {
+			assigned_cols[j++] = c;
+		}
+	}
+	assigned_cols.shrink(i - j);
+	Propagator::notifyBacktrack(untillevel, decision);
+}
+
+void GaussPropagator::printStatistics() const {
+	std::clog << "> gauss                 : " << nrows << " rows, " << ncols << " columns, " << propagations << " propagations, " << conflicts
+			<< " conflicts, " << pauses << " pauses\n";
+}
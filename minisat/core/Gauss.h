@@ -0,0 +1,109 @@
+/****************************************************************************************[Gauss.h]
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT
+NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT
+OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+**************************************************************************************************/
+
+#ifndef Minisat_Gauss_h
+#define Minisat_Gauss_h
+
+#include "minisat/core/Solver.h"
+
+namespace Minisat {
+
+//=================================================================================================
+// GaussPropagator -- propagates a set of XOR constraints by Gauss-Jordan elimination:
+//
+// The constraints form one matrix over GF(2), with a packed row of 64 bit words per constraint and
+// a column per variable, kept in reduced row echelon form. When the pivot of a row is assigned,
+// another unassigned variable of the row becomes its pivot, so a row with one unassigned variable
+// implies it and a row without any is either satisfied or a conflict. Rows are only changed by
+// adding other rows, which stays valid after backtracking, so backtracking only clears assignments.
+//
+// Explanations are lazy: the row that implied a variable is copied, and only turned into a clause
+// when 'getExplanation()' asks for it. The assignments are read as slices of the trail of the
+// 'Solver' (see 'Solver::trailSlice()'). If the matrix does not propagate for a while, it backs off:
+// it only follows the assignments and checks the rows again after exponentially growing pauses.
+// The CNF encoding of the constraints stays in the solver, so pausing is always sound.
+
+class GaussPropagator: public MinisatID::Propagator {
+public:
+    GaussPropagator(MinisatID::PCSolver* s, Solver& sat, const std::vector<Xor>& xors);
+    ~GaussPropagator();
+
+    //PROPAGATOR CODE
+    const char* getName         ()                                const { return "gauss"; }
+    CRef        getExplanation  (const Lit& l);
+    void        finishParsing   (bool& present)                         { present = true; }
+    void        notifyBacktrack (int untillevel, const Lit& decision);
+    CRef        notifypropagate ();
+    void        printStatistics ()                                const;
+    int         getNbOfFormulas ()                                const { return nrows; }
+
+    int         nRows           ()                                const { return nrows; }
+    int         nColumns        ()                                const { return ncols; }
+
+    // Statistics: (read-only member variable)
+    //
+    uint64_t    propagations, conflicts, pivot_swaps, pauses;
+
+protected:
+    Solver&          solver;
+    int              head;            // Queue head into the trail of 'solver'.
+    int              nrows, ncols;
+    int              words;           // Number of 64 bit words per row.
+    bool             unsat;           // The constraints are inconsistent (found when building the matrix).
+
+    vec<Var>         colvar;          // The variable of each column.
+    vec<int>         varcol;          // The column of each variable, or -1.
+    vec<uint64_t>    matrix;          // Row 'r' is 'matrix[r*words .. (r+1)*words)'.
+    vec<char>        rhs;             // The parity of each row.
+    vec<int>         pivot;           // The pivot column of each row.
+    vec<int>         pivotrow;        // The row of which each column is the pivot, or -1.
+    vec<uint64_t>    assigned;        // Columns assigned (as far as this propagator has read the trail).
+    vec<uint64_t>    values;          // Columns assigned true.
+    vec<int>         assigned_cols;
+    vec<char>        touched;         // Rows to check for propagation or conflict.
+    vec<int>         touched_rows;
+    vec<uint64_t>    reasons;         // For each column implied by a row, a copy of that row.
+
+    // Backing off:
+    uint64_t         calls;           // Number of calls of 'notifypropagate()' that checked rows since the last propagation.
+    uint64_t         pause;           // Number of calls to pause after the next unproductive period.
+    uint64_t         paused_until;
+    uint64_t         total_calls;
+
+    static const int Unproductive = 4096; // Calls of 'notifypropagate()' without propagations before pausing.
+
+    uint64_t*        row        (int r)       { return &matrix[r * words]; }
+    const uint64_t*  row        (int r) const { return &matrix[r * words]; }
+    static bool      has        (const uint64_t* bits, int c) { return (bits[c >> 6] >> (c & 63)) & 1; }
+    static void      set        (uint64_t* bits, int c)       { bits[c >> 6] |= (uint64_t)1 << (c & 63); }
+    static void      clear      (uint64_t* bits, int c)       { bits[c >> 6] &= ~((uint64_t)1 << (c & 63)); }
+
+    void             addRow     (int to, int from);            // Row 'to' += row 'from'.
+    void             swapRows   (int a, int b);
+    void             eliminate  ();                            // Bring the matrix in reduced row echelon form.
+    void             assign     (Lit p);                       // Record that 'p' became true, possibly choosing a new pivot.
+    void             repivot    (int r);                       // Choose an unassigned pivot for row 'r', if it has one.
+    void             touch      (int r);
+    void             touchAll   ();
+    CRef             checkRow   (int r);                       // Propagate or return a conflict for row 'r', if possible.
+    CRef             makeClause (const uint64_t* bits, Lit implied) const; // The clause of row 'bits' given the current assignment.
+};
+
+//=================================================================================================
+}
+
+#endif
@@ -0,0 +1,81 @@
+/***********************************************************************************[Heuristics.h]
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT
+NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT
+OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+**************************************************************************************************/
+
+#ifndef Minisat_Heuristics_h
+#define Minisat_Heuristics_h
+
+#include "minisat/mtl/IntTypes.h"
+#include "minisat/mtl/Vec.h"
+#include "minisat/core/SolverTypes.h"
+
+namespace Minisat {
+
+//=================================================================================================
+// Decision heuristics selectable with the 'heuristic' option:
+
+enum { heur_vsids = 0, heur_vmtf = 1, heur_chb = 2 };
+
+//=================================================================================================
+// VmtfQueue -- variable move-to-front queue:
+//
+// All variables are kept in a doubly linked list, ordered by the time they were last bumped (the
+// most recently bumped one last). Bumping is O(1) and there is no heap. 'search' points to a
+// variable such that all variables after it are assigned (or not decidable), so the next decision
+// is found by walking back from it; unassigning a variable moves 'search' forward if needed.
+
+class VmtfQueue {
+    struct Link { Var prev, next; };
+
+    vec<Link>     links;
+    vec<uint64_t> stamp;    // Time of the last bump.
+    Var           first, last;
+    Var           search;
+    uint64_t      counter;
+
+    void unlink(Var v) {
+        Link& l = links[v];
+        if (l.prev != var_Undef) links[l.prev].next = l.next; else first = l.next;
+        if (l.next != var_Undef) links[l.next].prev = l.prev; else last  = l.prev; }
+
+    void append(Var v) {
+        links[v].prev = last;
+        links[v].next = var_Undef;
+        if (last != var_Undef) links[last].next = v; else first = v;
+        last     = v;
+        stamp[v] = ++counter; }
+
+public:
+    VmtfQueue() : first(var_Undef), last(var_Undef), search(var_Undef), counter(0) {}
+
+    void     newVar (Var v)       { assert(v == links.size()); links.push(); stamp.push(0); append(v); }
+    void     bump   (Var v)       { if (v != last) { unlink(v); append(v); } else stamp[v] = ++counter; }
+    void     update (Var v)       { if (search == var_Undef || stamp[v] > stamp[search]) search = v; } // 'v' became a candidate again.
+    void     reset  ()            { search = last; }
+    bool     empty  ()      const { return search == var_Undef; }   // True if no candidate is known ('next()' found none).
+    double   score  (Var v) const { return (double)stamp[v]; }
+
+    // The most recently bumped unassigned decision variable, or 'var_Undef':
+    Var next(const vec<lbool>& assigns, const vec<char>& decision) {
+        while (search != var_Undef && (assigns[search] != l_Undef || !decision[search]))
+            search = links[search].prev;
+        return search; }
+};
+
+//=================================================================================================
+}
+
+#endif
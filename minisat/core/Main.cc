@@ -63,6 +63,11 @@ static void SIGINT_exit(int signum) {
         printf("\n"); printf("*** INTERRUPTED ***\n"); }
     _exit(1); }
 
+/*AB*/
+// Ask the solver to write its statistics (see 'StatsRegistry::requestDump()'):
+static void SIGUSR1_stats(int signum) { StatsRegistry::requestDump(); }
+/*AE*/
+
 
 //=================================================================================================
 // Main:
@@ -84,6 +89,7 @@ int main(int argc, char** argv)
         IntOption    verb   ("MAIN", "verb",   "Verbosity level (0=silent, 1=some, 2=more).", 1, IntRange(0, 2));
         IntOption    cpu_lim("MAIN", "cpu-lim","Limit on CPU time allowed in seconds.\n", INT32_MAX, IntRange(0, INT32_MAX));
         IntOption    mem_lim("MAIN", "mem-lim","Limit on memory usage in megabytes.\n", INT32_MAX, IntRange(0, INT32_MAX));
+        /*A*/IntOption    parse_threads("MAIN", "parse-threads", "Threads to parse an uncompressed input file with (0=one per core).\n", 0, IntRange(0, 256));
         
         parseOptions(argc, argv, true);
 
@@ -97,6 +103,11 @@ int main(int argc, char** argv)
         // interrupts:
         signal(SIGINT, SIGINT_exit);
         signal(SIGXCPU,SIGINT_exit);
+        /*AB*/
+#ifdef SIGUSR1
+        signal(SIGUSR1,SIGUSR1_stats);
+#endif
+        /*AE*/
 
         // Set limit on CPU-time:
         if (cpu_lim != INT32_MAX){
@@ -122,16 +133,20 @@ int main(int argc, char** argv)
         if (argc == 1)
             printf("Reading from standard input... Use '--help' for help.\n");
         
-        gzFile in = (argc == 1) ? gzdopen(0, "rb") : gzopen(argv[1], "rb");
-        if (in == NULL)
-            printf("ERROR! Could not open file: %s\n", argc == 1 ? "<stdin>" : argv[1]), exit(1);
-        
+        /*AB*/
         if (S.verbosity > 0){
             printf("============================[ Problem Statistics ]=============================\n");
             printf("|                                                                             |\n"); }
-        
-        parse_DIMACS(in, S);
-        gzclose(in);
+
+        if (argc == 1){
+            gzFile in = gzdopen(0, "rb");
+            if (in == NULL)
+                printf("ERROR! Could not open file: %s\n", "<stdin>"), exit(1);
+            parse_DIMACS(in, S);
+            gzclose(in);
+        }else
+            parse_DIMACS(argv[1], S, parse_threads);
+        /*AE*/
         FILE* res = (argc >= 3) ? fopen(argv[2], "wb") : NULL;
         
         if (S.verbosity > 0){
@@ -156,6 +171,8 @@ int main(int argc, char** argv)
                 printStats(S);
                 printf("\n"); }
             printf("UNSATISFIABLE\n");
+            if (S.stats_file != NULL) S.writeStats();
+            S.closeProof();
             exit(20);
         }
         
@@ -180,6 +197,7 @@ int main(int argc, char** argv)
         }
         
 #ifdef NDEBUG
+        S.closeProof();
         exit(ret == l_True ? 10 : ret == l_False ? 20 : 0);     // (faster than "return", which will invoke the destructor for 'Solver')
 #else
         return (ret == l_True ? 10 : ret == l_False ? 20 : 0);
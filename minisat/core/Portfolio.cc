@@ -0,0 +1,110 @@
+/***********************************************************************************[Portfolio.cc]
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT
+NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT
+OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+**************************************************************************************************/
+
+#include <atomic>
+#include <thread>
+#include <vector>
+#include <iostream>
+
+#include "minisat/core/Portfolio.h"
+
+using namespace Minisat;
+
+//=================================================================================================
+// Constructor/Destructor:
+
+Portfolio::Portfolio(int log2_queue_capacity) : log2_capacity(log2_queue_capacity), win(-1) {}
+
+Portfolio::~Portfolio() {}
+
+void Portfolio::addSolver(Solver* s, bool diversify_settings) {
+	if (diversify_settings) {
+		diversify(*s, solvers.size());
+	}
+	if (s->proofEnabled()) { // NOTE: the imported clauses cannot be derived from its own clauses
+		std::clog << "A solver of a portfolio cannot write a proof, closing it.\n";
+		s->closeProof();
+	}
+	s->drat_file = NULL;
+	s->stats_file = NULL; // NOTE: the solvers would all write the file of '-stats-json', on SIGUSR1 they write to standard error instead
+	solvers.push(s);
+}
+
+void Portfolio::diversify(Solver& s, int i) {
+	if (i == 0) {
+		return;
+	}
+	s.random_seed = 91648253 + 1000003 * i; // NOTE: must never be 0
+	s.luby_restart = i % 2 == 0;
+	s.phase_saving = i % 4 == 3 ? 1 : 2;
+	s.var_decay = 0.95 - 0.01 * (i % 5);
+	s.ccmin_mode = i % 6 == 5 ? 1 : 2;
+	if (i % 4 == 2) {
+		s.random_var_freq = 0.01;
+	}
+}
+
+//=================================================================================================
+// Solving:
+
+void Portfolio::interrupt() {
+	for (int i = 0; i < solvers.size(); i++) {
+		solvers[i]->interrupt();
+	}
+}
+
+lbool Portfolio::solve(const vec<Lit>& assumps) {
+	int n = solvers.size();
+	ClauseExchange exchange(n, log2_capacity);
+	std::vector<lbool> results(n, l_Undef);
+	std::atomic<int> first(-1);
+
+	for (int i = 0; i < n; i++) {
+		solvers[i]->clearInterrupt();
+		solvers[i]->setClauseExchange(&exchange, i);
+	}
+
+	std::vector<std::thread> threads;
+	for (int i = 0; i < n; i++) {
+		threads.push_back(std::thread([this, i, &assumps, &results, &first]() {
+			results[i] = solvers[i]->solveLimited(assumps);
+			int none = -1;
+			if (results[i] != l_Undef && first.compare_exchange_strong(none, i)) {
+				interrupt();
+			}
+		}));
+	}
+	for (auto t = threads.begin(); t < threads.end(); ++t) {
+		t->join();
+	}
+
+	for (int i = 0; i < n; i++) {
+		solvers[i]->setClauseExchange(NULL, 0);
+		solvers[i]->clearInterrupt();
+	}
+
+	win = first.load();
+	return win == -1 ? l_Undef : results[win];
+}
+
+void Portfolio::printStatistics() const {
+	for (int i = 0; i < solvers.size(); i++) {
+		const Solver& s = *solvers[i];
+		std::clog << "> solver " << i << (i == win ? " (winner)" : "") << ": " << s.conflicts << " conflicts, " << s.shared_exported << " exported, "
+				<< s.shared_imported << " imported (" << s.shared_useful << " useful)\n";
+	}
+}
@@ -0,0 +1,60 @@
+/************************************************************************************[Portfolio.h]
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT
+NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT
+OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+**************************************************************************************************/
+
+#ifndef Minisat_Portfolio_h
+#define Minisat_Portfolio_h
+
+#include "minisat/core/Solver.h"
+#include "minisat/core/ClauseExchange.h"
+
+namespace Minisat {
+
+//=================================================================================================
+// Portfolio -- runs several solvers on the same problem, each on its own thread:
+//
+// The solvers are created (and given the problem) by the caller, as each one needs its own PCSolver.
+// The first solver to finish wins, the others are stopped with 'interrupt()'. Meanwhile they share
+// short learnt clauses through a 'ClauseExchange'.
+
+class Portfolio {
+public:
+    explicit Portfolio(int log2_queue_capacity = 12);
+    ~Portfolio();
+
+    void    addSolver      (Solver* s, bool diversify = true); // Solver 'i' gets the settings of 'diversify(s, i)'.
+    int     nSolvers       ()      const { return solvers.size(); }
+    Solver& getSolver      (int i) const { return *solvers[i]; }
+
+    lbool   solve          (const vec<Lit>& assumps);           // The answer of the first solver to finish, l_Undef if all were interrupted.
+    int     winner         ()      const { return win; }        // Index of the solver that gave the answer of the last 'solve()', or -1.
+    void    interrupt      ();                                  // Stop all solvers (asynchronously).
+
+    void    printStatistics() const;
+
+    // Settings for solver 'i' of a portfolio, solver 0 keeps the defaults:
+    static void diversify  (Solver& s, int i);
+
+protected:
+    vec<Solver*>    solvers;
+    int             log2_capacity;
+    int             win;
+};
+
+//=================================================================================================
+}
+
+#endif
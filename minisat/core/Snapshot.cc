@@ -0,0 +1,276 @@
+/************************************************************************************[Snapshot.cc]
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT
+NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT
+OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+**************************************************************************************************/
+
+#include <stdio.h>
+#include <string.h>
+
+#include "minisat/core/Solver.h"
+#include "minisat/utils/ParseUtils.h"
+
+#include "utils/Utils.hpp"
+#include "theorysolvers/PCSolver.hpp"
+
+using namespace Minisat;
+
+//=================================================================================================
+// Snapshot format:
+//
+// A header followed by sections in a fixed order, each padded to a multiple of 8 bytes:
+//
+//   activity, polarity, initial_polarity,      -- one entry per variable
+//   user_pol, decision
+//   trail                                      -- the root level literals (and the pending 'rootunitlits')
+//   arena, learnt arena                        -- the regions of the 'ClauseAllocator', verbatim
+//   clauses, learnts_core, learnts_mid, learnts_local  -- 'CRef's into the arena
+//
+// Everything is in native byte order and references have the width of 'CRef': a snapshot is meant to
+// warm start the same build on the same machine, not to be exchanged. The file is mapped to read it, so loading copies every section once
+// and only rebuilds the watcher lists.
+//
+// Of the decision heuristic, only 'activity' is kept: all of VSIDS, the scores of CHB without its step size, and nothing
+// of the queue of VMTF, which starts in variable order again. A snapshot only loads into a solver with the same heuristic.
+
+namespace {
+
+const char     Snapshot_Magic[8] = { 'M', 'S', 'A', 'T', 'S', 'N', 'A', 'P' };
+const uint32_t Snapshot_Version  = 4;
+const uint32_t Snapshot_Order    = 0x01020304;
+
+struct SnapshotHeader {
+	char     magic[8];
+	uint32_t version;
+	uint32_t byte_order;
+	uint32_t ok;
+	uint32_t extra_clause_field;
+	uint32_t nvars;
+	uint32_t heuristic;
+	uint32_t ref_size;
+	uint32_t unused;
+	double   var_inc;
+	double   cla_inc;
+	uint64_t ntrail;
+	uint64_t arena_size;
+	uint64_t arena_wasted;
+	uint64_t learnt_arena_size;
+	uint64_t learnt_arena_wasted;
+	uint64_t nclauses;
+	uint64_t ncore;
+	uint64_t nmid;
+	uint64_t nlocal;
+};
+
+inline uint64_t padded(uint64_t bytes) {
+	return (bytes + 7) & ~(uint64_t) 7;
+}
+
+bool writePadding(FILE* f, uint64_t bytes) {
+	static const char zeros[8] = { 0 };
+	uint64_t pad = padded(bytes) - bytes;
+	return pad == 0 || fwrite(zeros, 1, pad, f) == pad;
+}
+
+bool writeSection(FILE* f, const void* data, uint64_t bytes) {
+	if (bytes > 0 && fwrite(data, 1, bytes, f) != bytes) {
+		return false;
+	}
+	return writePadding(f, bytes);
+}
+
+// The arena is not necessarily contiguous (see 'SegmentedAllocator'), so it is written a piece at a time:
+bool writeArena(FILE* f, const ClauseAllocator& ca, bool learnt) {
+	for (ClauseAllocator::Size r = 0; r < ca.size(learnt);) {
+		ClauseAllocator::Size n;
+		const uint32_t* piece = ca.data(learnt, r, n);
+		if (fwrite(piece, sizeof(uint32_t), n, f) != n) {
+			return false;
+		}
+		r += n;
+	}
+	return writePadding(f, sizeof(uint32_t) * (uint64_t) ca.size(learnt));
+}
+
+// Returns the section at 'p' and moves 'p' past it:
+const char* section(const char*& p, uint64_t bytes) {
+	const char* s = p;
+	p += padded(bytes);
+	return s;
+}
+
+}
+
+//=================================================================================================
+// Writing and reading:
+
+bool Solver::writeSnapshot(const char* file) {
+	if (checkpoints.size() > 0) {
+		return false;
+	}
+	FILE* f = fopen(file, "wb");
+	if (f == NULL) {
+		return false;
+	}
+
+	// Not only the trail below 'trail_lim[0]': literals kept by chronological backtracking and units added
+	// above the root (see 'injectClause()') are at level 0 higher up, and 'rootunitlits' may wait for the root.
+	vec<Lit> roots;
+	for (int i = 0; i < trail.size(); i++) {
+		if (level(var(trail[i])) == 0) {
+			roots.push(trail[i]);
+		}
+	}
+	for (size_t i = 0; i < rootunitlits.size(); i++) {
+		Lit p = rootunitlits[i];
+		if (value(p) != l_True || level(var(p)) > 0) {
+			roots.push(p);
+		}
+	}
+
+	SnapshotHeader h;
+	memset(&h, 0, sizeof(h));
+	memcpy(h.magic, Snapshot_Magic, sizeof(h.magic));
+	h.version = Snapshot_Version;
+	h.byte_order = Snapshot_Order;
+	h.ok = ok;
+	h.extra_clause_field = ca.extra_clause_field;
+	h.nvars = nVars();
+	h.heuristic = heuristic;
+	h.ref_size = sizeof(CRef);
+	h.var_inc = var_inc;
+	h.cla_inc = cla_inc;
+	h.ntrail = roots.size();
+	h.arena_size = ca.size(false);
+	h.arena_wasted = ca.wasted(false);
+	h.learnt_arena_size = ca.size(true);
+	h.learnt_arena_wasted = ca.wasted(true);
+	h.nclauses = clauses.size();
+	h.ncore = learnts_core.size();
+	h.nmid = learnts_mid.size();
+	h.nlocal = learnts_local.size();
+
+	vec<uint8_t> upol(nVars());
+	for (int v = 0; v < nVars(); v++) {
+		upol[v] = toInt(user_pol[v]);
+	}
+
+	bool good = fwrite(&h, sizeof(h), 1, f) == 1;
+	good = good && writeSection(f, (const double*) activity, sizeof(double) * nVars());
+	good = good && writeSection(f, (const char*) polarity, nVars());
+	good = good && writeSection(f, (const char*) initial_polarity, nVars());
+	good = good && writeSection(f, (const uint8_t*) upol, nVars());
+	good = good && writeSection(f, (const char*) decision, nVars());
+	good = good && writeSection(f, (const Lit*) roots, sizeof(Lit) * roots.size());
+	good = good && writeArena(f, ca, false);
+	good = good && writeArena(f, ca, true);
+	good = good && writeSection(f, (const CRef*) clauses, sizeof(CRef) * clauses.size());
+	good = good && writeSection(f, (const CRef*) learnts_core, sizeof(CRef) * learnts_core.size());
+	good = good && writeSection(f, (const CRef*) learnts_mid, sizeof(CRef) * learnts_mid.size());
+	good = good && writeSection(f, (const CRef*) learnts_local, sizeof(CRef) * learnts_local.size());
+	good = fclose(f) == 0 && good;
+	return good;
+}
+
+bool Solver::readSnapshot(const char* file) {
+	if (nVars() > 0 || clauses.size() > 0 || ca.size() > 0 || checkpoints.size() > 0) {
+		return false;
+	}
+	MappedFile f(file);
+	if (f.data == NULL || f.size < sizeof(SnapshotHeader)) {
+		return false;
+	}
+	SnapshotHeader h;
+	memcpy(&h, f.data, sizeof(h));
+	if (memcmp(h.magic, Snapshot_Magic, sizeof(h.magic)) != 0 || h.version != Snapshot_Version || h.byte_order != Snapshot_Order
+			|| h.ref_size != sizeof(CRef) || h.heuristic != (uint32_t) heuristic) {
+		return false;
+	}
+	uint64_t n = h.nvars;
+	uint64_t expected = sizeof(h) + padded(sizeof(double) * n) + 4 * padded(n) + padded(sizeof(Lit) * h.ntrail)
+			+ padded(sizeof(uint32_t) * h.arena_size) + padded(sizeof(uint32_t) * h.learnt_arena_size)
+			+ padded(sizeof(CRef) * h.nclauses) + padded(sizeof(CRef) * h.ncore) + padded(sizeof(CRef) * h.nmid)
+			+ padded(sizeof(CRef) * h.nlocal);
+	if (f.size != expected) {
+		return false;
+	}
+
+	const char* p = f.data + sizeof(h);
+	const double* act = (const double*) section(p, sizeof(double) * n);
+	const char* pol = section(p, n);
+	const char* initial_pol = section(p, n);
+	const uint8_t* upol = (const uint8_t*) section(p, n);
+	const char* dec = section(p, n);
+	const Lit* roots = (const Lit*) section(p, sizeof(Lit) * h.ntrail);
+	const uint32_t* arena = (const uint32_t*) section(p, sizeof(uint32_t) * h.arena_size);
+	const uint32_t* learnt_arena = (const uint32_t*) section(p, sizeof(uint32_t) * h.learnt_arena_size);
+
+	// Variables (through 'newVar()', so all per variable data and PCSolver are kept consistent):
+	reserve(n, h.nclauses, h.arena_size);
+	for (uint64_t v = 0; v < n; v++) {
+		newVar(toLbool(upol[v]), dec[v]);
+	}
+	memcpy(&activity[0], act, sizeof(double) * n);
+	memcpy(&polarity[0], pol, n);
+	memcpy(&initial_polarity[0], initial_pol, n);
+	var_inc = h.var_inc;
+	cla_inc = h.cla_inc;
+
+	// Clauses:
+	ca.extra_clause_field = h.extra_clause_field;
+	ca.copyFrom(false, arena, h.arena_size, h.arena_wasted);
+	ca.copyFrom(true, learnt_arena, h.learnt_arena_size, h.learnt_arena_wasted);
+	const CRef* cs = (const CRef*) section(p, sizeof(CRef) * h.nclauses);
+	for (uint64_t i = 0; i < h.nclauses; i++) {
+		addToClauses(cs[i], false);
+	}
+	vec<CRef>* tiers[3] = { &learnts_core, &learnts_mid, &learnts_local };
+	uint64_t sizes[3] = { h.ncore, h.nmid, h.nlocal };
+	for (int t = 0; t < 3; t++) {
+		const CRef* ls = (const CRef*) section(p, sizeof(CRef) * sizes[t]);
+		for (uint64_t i = 0; i < sizes[t]; i++) {
+			getPCSolver().notifyClauseAdded(ls[i]); // (kept in their tier, unlike 'addToClauses()')
+			tiers[t]->push(ls[i]);
+		}
+	}
+	attachClauses(clauses, 0);
+	for (int t = 0; t < 3; t++) {
+		attachClauses(*tiers[t], 0);
+	}
+
+	// Root level:
+	ok = h.ok;
+	for (uint64_t i = 0; i < h.ntrail && ok; i++) {
+		if (value(roots[i]) == l_False) {
+			ok = false;
+		} else if (value(roots[i]) == l_Undef) {
+			uncheckedEnqueue(roots[i]);
+		}
+	}
+	if (ok && propagate() != CRef_Undef) {
+		ok = false;
+	}
+	if (ok) {
+		for (int i = 0; i < clauses.size(); i++) {
+			checkDecisionVars(ca[clauses[i]]);
+		}
+		for (int t = 0; t < 3; t++) {
+			for (int i = 0; i < tiers[t]->size(); i++) {
+				checkDecisionVars(ca[(*tiers[t])[i]]);
+			}
+		}
+	}
+	rebuildOrderHeap();
+	return true;
+}
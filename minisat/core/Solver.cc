@@ -22,18 +22,28 @@
 
 #include "minisat/mtl/Sort.h"
 #include "minisat/core/Solver.h"
+/*A*/#include "minisat/core/ClauseExchange.h"
+/*A*/#include "minisat/core/Gauss.h"
 
 /*AB*/
 #include "minisat/mtl/Vec.h"
 #include "minisat/mtl/Heap.h"
 #include "minisat/mtl/Alg.h"
 #include "minisat/utils/Options.h"
+/*A*/#include "minisat/utils/System.h"
 
 #include <vector>
 #include <iostream>
 #include <sstream>
 #include <cstdarg>
 #include <algorithm>
+/*AB*/
+#include <atomic>
+#include <chrono>
+#ifdef __AVX2__
+#include <immintrin.h>
+#endif
+/*AE*/
 
 #include "utils/Utils.hpp"
 #include "utils/Print.hpp"
@@ -72,6 +82,57 @@ static IntOption opt_restart_first(_cat, "rfirst", "The base restart interval",
 static DoubleOption opt_restart_inc(_cat, "rinc", "Restart interval increase factor", 2, DoubleRange(1, false, HUGE_VAL, false));
 static DoubleOption opt_garbage_frac(_cat, "gc-frac", "The fraction of wasted memory allowed before a garbage collection is triggered", 0.20,
 		DoubleRange(0, false, HUGE_VAL, false));
+/*AB*/
+static IntOption opt_core_lbd(_cat, "core-lbd", "Learnt clauses with at most this glue are never removed", 2, IntRange(0, INT32_MAX));
+static IntOption opt_mid_lbd(_cat, "mid-lbd", "Learnt clauses with at most this glue are kept as long as they are used", 6, IntRange(0, INT32_MAX));
+static BoolOption opt_glue_restart(_cat, "glue-restart", "Restart based on moving averages of learnt clause glue (instead of luby/geometric)", false);
+static DoubleOption opt_restart_margin(_cat, "restart-margin", "Glue restart if the recent glue average exceeds the long-term one by this factor", 1.25,
+		DoubleRange(1, true, HUGE_VAL, false));
+static IntOption opt_restart_min(_cat, "restart-min", "Minimal number of conflicts between glue restarts", 50, IntRange(1, INT32_MAX));
+static DoubleOption opt_block_margin(_cat, "block-margin", "Block a glue restart if the trail is this factor longer than average (0=never)", 1.4,
+		DoubleRange(0, true, HUGE_VAL, false));
+static IntOption opt_block_after(_cat, "block-after", "Never block restarts during this many first conflicts", 10000, IntRange(0, INT32_MAX));
+static BoolOption opt_partial_restart(_cat, "partial-restart", "Keep the decisions that are more active than the next decision on restart", false);
+static BoolOption opt_reuse_assumps(_cat, "reuse-assumps", "Keep the decision levels of the assumptions that the next call to solve() shares with the last one", true);
+static BoolOption opt_pack_assumps(_cat, "pack-assumps", "Put all assumptions on a single decision level", false);
+static IntOption opt_heuristic(_cat, "heuristic", "Decision heuristic (0=vsids, 1=vmtf, 2=chb)", 0, IntRange(0, 2));
+static IntOption opt_chrono(_cat, "chrono", "Backtrack one level only if a backjump would undo more levels than this (-1=never)", -1, IntRange(-1, INT32_MAX));
+static IntOption opt_chrono_after(_cat, "chrono-after", "Never backtrack chronologically during this many first conflicts", 4000, IntRange(0, INT32_MAX));
+static IntOption opt_share_lbd(_cat, "share-lbd", "Learnt clauses with at most this glue are shared in portfolio mode", 3, IntRange(0, INT32_MAX));
+static IntOption opt_bin_min(_cat, "bin-min", "Minimize learnt clauses with at most this glue with binary clauses (0=never)", 6, IntRange(0, INT32_MAX));
+static BoolOption opt_otfs(_cat, "otfs", "Strengthen reasons subsumed by an intermediate resolvent during conflict analysis", true);
+static BoolOption opt_inprocess(_cat, "inprocess", "Periodically subsume/strengthen new clauses and vivify learnt clauses at the root level", false);
+static IntOption opt_inprocess_int(_cat, "inprocess-int", "Conflicts before the first inprocessing round (the interval grows linearly)", 10000, IntRange(1, INT32_MAX));
+static DoubleOption opt_inprocess_frac(_cat, "inprocess-frac", "Inprocessing effort, as a fraction of the propagations of search since the last round", 0.1,
+		DoubleRange(0, false, HUGE_VAL, false));
+static BoolOption opt_gauss(_cat, "gauss", "Detect XOR constraints and propagate them by Gauss-Jordan elimination", false);
+static IntOption opt_xor_size(_cat, "xor-size", "Maximal size of the XOR constraints to detect", 5, IntRange(3, 6));
+static BoolOption opt_lazy_decidable(_cat, "lazy-decide", "Only make variables decidable once a clause needs them (off: all variables are decidable)", true);
+static StringOption opt_stats_file(_cat, "stats-json", "Write the statistics and timers as JSON to this file ('-' for stderr) at the end and on SIGUSR1");
+static IntOption opt_stats_interval(_cat, "stats-interval", "Record a row of statistics every this many conflicts instead of printing the progress table (0=never)", 0,
+		IntRange(0, INT32_MAX));
+static StringOption opt_drat_file(_cat, "drat", "Write a binary DRAT proof to this file (gzip compressed if it ends in '.gz')");
+static std::atomic<bool> drat_claimed(false); // NOTE: the file of '-drat' is opened by one solver only, the first to need it
+static IntOption opt_mem_budget(_cat, "mem-budget", "Megabytes the clauses and their watchers should fit in, the learnt clauses are reduced harder near it (0=no budget)", 0,
+		IntRange(0, INT32_MAX));
+static IntOption opt_stable_mode(_cat, "stable-mode", "Search modes (0=focused only, 1=alternate focused and stable, 2=stable only)", 0, IntRange(0, 2));
+static IntOption opt_mode_init(_cat, "mode-init", "Conflicts of the first focused mode, its ticks are the length of the next modes", 1000, IntRange(1, INT32_MAX));
+static IntOption opt_stable_restart_first(_cat, "stable-rfirst", "The Luby unit of the restart intervals of stable mode", 1024, IntRange(1, INT32_MAX));
+static DoubleOption opt_stable_var_decay(_cat, "stable-var-decay", "The variable activity decay factor of stable mode", 0.975, DoubleRange(0, false, 1, false));
+static IntOption opt_target_mode(_cat, "target-phase", "Decide the phase of the largest conflict-free trail since the last restart (0=never, 1=in stable mode, 2=always)", 1,
+		IntRange(0, 2));
+static IntOption opt_rephase_int(_cat, "rephase-int", "Conflicts between two rephasings with '-stable-mode', the interval grows linearly (0=never)", 1000,
+		IntRange(0, INT32_MAX));
+static DoubleOption opt_walk_effort(_cat, "walk-effort", "Random walk effort of rephasing, as a fraction of the ticks of search since the last walk", 0.1,
+		DoubleRange(0, true, HUGE_VAL, false));
+
+static const double mem_soft        = 0.75; // Above this fraction of the memory budget, the learnt clauses stop growing and are reduced harder.
+static const double mem_min_learnts = 1000; // The memory budget does not lower the limit of learnt clauses below this.
+
+static const int prefetch_distance = 8; // 'notifypropagate()' fetches the clause of the watcher this far ahead early.
+
+static const uint64_t deadline_poll_ticks = 1 << 16; // 'withinBudget()' reads the clock at most once per this many ticks (well below a millisecond).
+/*AE*/
 
 //=================================================================================================
 // Constructor/Destructor:
@@ -85,6 +146,14 @@ Solver::Solver(/*AB*/PCSolver* s/*AE*/)
 			var_decay(opt_var_decay), clause_decay(opt_clause_decay), random_var_freq(opt_random_var_freq), random_seed(opt_random_seed),
 			luby_restart(opt_luby_restart), ccmin_mode(opt_ccmin_mode), phase_saving(opt_phase_saving), rnd_pol(false), rnd_init_act(opt_rnd_init_act),
 			garbage_frac(opt_garbage_frac), restart_first(opt_restart_first), restart_inc(opt_restart_inc)
+			/*AB*/
+			, glue_restart(opt_glue_restart), restart_margin(opt_restart_margin), restart_min(opt_restart_min), block_margin(opt_block_margin),
+			block_after(opt_block_after), partial_restart(opt_partial_restart), reuse_assumps(opt_reuse_assumps), pack_assumps(opt_pack_assumps), chrono(opt_chrono), chrono_after(opt_chrono_after),
+			bin_min(opt_bin_min), otfs(opt_otfs), use_inprocess(opt_inprocess), inprocess_int(opt_inprocess_int), inprocess_frac(opt_inprocess_frac),
+			gauss(opt_gauss), xor_size(opt_xor_size), stats_file(opt_stats_file), drat_file(opt_drat_file), stats_interval(opt_stats_interval), mem_budget((uint64_t) opt_mem_budget << 20),
+			stable_mode(opt_stable_mode), mode_init(opt_mode_init), stable_restart_first(opt_stable_restart_first), stable_var_decay(opt_stable_var_decay),
+			target_mode(opt_target_mode), rephase_int(opt_rephase_int), walk_effort(opt_walk_effort)
+			/*AE*/
 
 			// Parameters (the rest):
 			//
@@ -95,6 +164,8 @@ Solver::Solver(/*AB*/PCSolver* s/*AE*/)
 			//
 					,
 			learntsize_adjust_start_confl(100), learntsize_adjust_inc(1.5)
+			/*A*/,
+			core_lbd(opt_core_lbd), mid_lbd(opt_mid_lbd), lazy_decidable(opt_lazy_decidable), share_lbd(opt_share_lbd)
 
 			/*A*/,
 			usecustomheur(false)
@@ -105,20 +176,97 @@ Solver::Solver(/*AB*/PCSolver* s/*AE*/)
 			//
 					,
 			solves(0), starts(0), decisions(0), rnd_decisions(0), propagations(0), conflicts(0), dec_vars(0), clauses_literals(0), learnts_literals(0),
-			max_literals(0), tot_literals(0), ok(true), cla_inc(1), var_inc(1), watches(WatcherDeleted(ca)), qhead(0), simpDB_assigns(-1), simpDB_props(0),
+			max_literals(0), tot_literals(0), /*A*/shared_exported(0), shared_imported(0), shared_useful(0), blocked_restarts(0), reused_levels(0), reused_assumption_levels(0), repaired_clauses(0), chrono_backtracks(0), bin_minimized(0), otf_strengthened(0), inprocessings(0), inproc_subsumed(0), inproc_strengthened(0), inproc_vivified(0), lookaheads(0), lookahead_probes(0), failed_literals(0), mode_conflicts(), mode_restarts(), mode_ticks(), mode_switches(0), rephases(0), walks(0), walk_flips(0), ticks(0), garbage_collections(0), learnt_collections(0), arena_bytes(0), watch_bytes(0), memory_reductions(0), ok(true), cla_inc(1), /*A*/heuristic(opt_heuristic), chb_alpha(0.4), var_inc(1), watches(WatcherDeleted(ca)), binwatches(WatcherDeleted(ca)),
+			/*A*/target_assigned(0), best_assigned(0), stable(opt_stable_mode == 2), mode_length(0), mode_end(0), next_rephase(opt_rephase_int), walk_ticks(0),
+			qhead(0), /*A*/batched_notify(false), batch_propagators(0), ema_glue_fast(0), ema_glue_slow(0), ema_trail(0), ema_count(0), simpDB_assigns(-1), /*A*/simpDB_ticks(0),
+			/*A*/packed(false), searching(false),
 			order_heap(VarOrderLt(activity)), progress_estimate(0), remove_satisfied(true)
+			/*A*/, vivify_next(0), next_inprocess(opt_inprocess_int), inprocess_props(0)
+			/*A*/, lbd_counter(0)
 			// Resource constraints:
 			//
 					,
-			conflict_budget(-1), propagation_budget(-1), asynch_interrupt(false) {
+			conflict_budget(-1), propagation_budget(-1), /*A*/tick_budget(-1), deadline(-1), deadline_poll(0), asynch_interrupt(false)
+			/*A*/, exchange(NULL), exchange_id(0), gauss_prop(NULL), export_clauses(0), export_roots(0)
+			/*A*/, epoch(0), analyze_epoch(0) {
 	/*AB*/
 	getPCSolver().accept(this, EV_PROPAGATE);
 	getPCSolver().accept(this, EV_PRINTSTATS);
 	getPCSolver().acceptFinishParsing(this, false);
+
+	stats.bind("solves", &solves);
+	stats.bind("restarts", &starts);
+	stats.bind("decisions", &decisions);
+	stats.bind("random_decisions", &rnd_decisions);
+	stats.bind("propagations", &propagations);
+	stats.bind("conflicts", &conflicts);
+	stats.bind("conflict_literals", &tot_literals);
+	stats.bind("conflict_literals_before_minimization", &max_literals);
+	stats.bind("chrono_backtracks", &chrono_backtracks);
+	stats.bind("blocked_restarts", &blocked_restarts);
+	stats.bind("reused_levels", &reused_levels);
+	stats.bind("reused_assumption_levels", &reused_assumption_levels);
+	stats.bind("repaired_clauses", &repaired_clauses); // (added above the root between calls, see 'reuseTrail()')
+	stats.bind("bin_minimized", &bin_minimized);
+	stats.bind("otf_strengthened", &otf_strengthened);
+	stats.bind("inprocessings", &inprocessings);
+	stats.bind("lookaheads", &lookaheads);
+	stats.bind("lookahead_probes", &lookahead_probes);
+	stats.bind("failed_literals", &failed_literals);
+	stats.bind("focused_conflicts", &mode_conflicts[0]);
+	stats.bind("stable_conflicts", &mode_conflicts[1]);
+	stats.bind("focused_restarts", &mode_restarts[0]);
+	stats.bind("stable_restarts", &mode_restarts[1]);
+	stats.bind("focused_ticks", &mode_ticks[0]);
+	stats.bind("stable_ticks", &mode_ticks[1]);
+	stats.bind("mode_switches", &mode_switches);
+	stats.bind("rephases", &rephases);
+	stats.bind("walks", &walks);
+	stats.bind("walk_flips", &walk_flips);
+	stats.bind("ticks", &ticks);
+	stats.bind("garbage_collections", &garbage_collections);
+	stats.bind("learnt_collections", &learnt_collections);
+	stats.bind("arena_bytes", &arena_bytes);
+	stats.bind("watch_bytes", &watch_bytes);
+	stats.bind("memory_reductions", &memory_reductions); // (times 'mem_budget' lowered the limit of learnt clauses)
+	stats.bind("shared_exported", &shared_exported);
+	stats.bind("shared_imported", &shared_imported);
+	st_watch_visits = stats.counter("watch_visits");
+	st_blocker_hits = stats.counter("blocker_hits");
+	st_clause_derefs = stats.counter("clause_derefs"); // (by propagation and conflict analysis)
+	st_glue = stats.histogram("learnt_glue", 32);
+	stats.bind("proof_records", &proof.records);
+	stats.bind("proof_stalls", &proof.stalls); // (waits for the proof writer)
+
+	// NOTE: the timers are inclusive: 'propagate' is the propagation by the PCSolver, including 'notifypropagate'
+	st_propagate = stats.timer("propagate");
+	st_notifypropagate = stats.timer("notifypropagate");
+	st_analyze = stats.timer("analyze");
+	st_litredundant = stats.timer("litRedundant");
+	st_reducedb = stats.timer("reduceDB");
+	st_collect = stats.timer("garbageCollect");
+	st_simplify = stats.timer("simplify");
+	st_inprocess = stats.timer("inprocess");
+	st_callbacks = stats.timer("callbacks"); // (explanations and full assignment checks of the PCSolver)
+
+	stats.column("conflicts");
+	stats.column("decisions");
+	stats.column("propagations");
+	stats.column("restarts");
+	stats.column("root_assigned");
+	stats.column("clauses");
+	stats.column("learnts");
+	stats.column("max_learnts");
+	stats.column("arena_bytes");
+	stats.column("watch_bytes");
+	stats.column("progress");
+
 	/*AE*/
 }
 
 Solver::~Solver() {
+	/*A*/delete gauss_prop;
+	/*A*/closeProof();
 }
 
 void Solver::setDecidable(Var v, bool decide) // NOTE: no-op if already a decision var!
@@ -154,11 +302,21 @@ Var Solver::newVar(lbool upol, bool dvar) {
 	int v = nVars();
 	watches.init(mkLit(v, false));
 	watches.init(mkLit(v, true));
+	/*A*/binwatches.init(mkLit(v, false));
+	/*A*/binwatches.init(mkLit(v, true));
 	assigns.push(l_Undef);
+	/*A*/assigns.capacity(v + 4); // (the vector search of 'firstNonFalse()' loads 4 bytes at each variable)
 	vardata.push(mkVarData(CRef_Undef, 0));
 	//activity .push(0);
 	activity.push(rnd_init_act ? drand(random_seed) * 0.00001 : 0);
+	/*AB*/
+	chb_conflict.push(0);
+	if (heuristic == heur_vmtf) {
+		vmtf.newVar(v);
+	}
+	/*AE*/
 	seen.push(0);
+	/*A*/root_epoch.push(0);
 
 	//if(getPCSolver().modes().lazy){
 	//	polarity.push(((float)rand()/ RAND_MAX)>0.5);
@@ -167,13 +325,42 @@ Var Solver::newVar(lbool upol, bool dvar) {
 	//}
 
 	user_pol.push(upol);
+	/*AB*/
+	initial_polarity.push(true);
+	target_phase.push(l_Undef);
+	best_phase.push(l_Undef);
+	/*AE*/
 	decision.push();
 	trail.capacity(v + 1);
 	getPCSolver().notifyVarAdded(); // NOTE: important before setting decidability
-	setDecidable(v, dvar);
+	setDecidable(v, dvar || not lazy_decidable);
 	return v;
 }
 
+/*AB*/
+// Grows the per variable data, the watch lists and the clause arena once, instead of step by step
+// while a large problem is added:
+void Solver::reserve(int nvars, int nclauses, uint64_t nlits) {
+	watches.capacity(2 * nvars);
+	binwatches.capacity(2 * nvars);
+	assigns.capacity(nvars);
+	vardata.capacity(nvars);
+	activity.capacity(nvars);
+	chb_conflict.capacity(nvars);
+	seen.capacity(nvars);
+	root_epoch.capacity(nvars);
+	polarity.capacity(nvars);
+	user_pol.capacity(nvars);
+	initial_polarity.capacity(nvars);
+	target_phase.capacity(nvars);
+	best_phase.capacity(nvars);
+	decision.capacity(nvars);
+	trail.capacity(nvars);
+	clauses.capacity(nclauses);
+	ca.capacity(nclauses, nlits);
+}
+/*AE*/
+
 inline void Solver::createNewDecisionLevel() {
 	trail_lim.push(trail.size());
 	/*A*/getPCSolver().newDecisionLevel();
@@ -185,6 +372,13 @@ void Solver::finishParsing(bool& present) {
 	if(not simplify()){
 		getPCSolver().notifyUnsat();
 	}
+	if (gauss && gauss_prop == NULL) {
+		std::vector<Xor> xors;
+		findXors(xors, xor_size);
+		if (not xors.empty()) {
+			gauss_prop = new GaussPropagator(&getPCSolver(), *this, xors);
+		}
+	}
 }
 
 std::vector<Lit> Solver::getDecisions() const {
@@ -198,6 +392,8 @@ std::vector<Lit> Solver::getDecisions() const {
 void Solver::addLearnedClause(CRef rc) {
 	Clause& c = ca[rc];
 	if (c.size() > 1) {
+		c.glue(computeLBD(c));
+		c.epoch(epoch); // NOTE: its antecedents are unknown, so it is assumed to depend on the latest clauses
 		addToClauses(rc, true);
 		attachClause(rc);
 		claBumpActivity(c);
@@ -208,7 +404,7 @@ void Solver::addLearnedClause(CRef rc) {
 		}
 	} else { // Adding literal true at level 0
 		assert(c.size()==1);
-		cancelUntil(0);
+		/*A*/// (no need to backtrack to the root, see 'injectClause()')
 		vec<Lit> ps;
 		ps.push(c[0]);
 		addClause(ps);
@@ -216,6 +412,8 @@ void Solver::addLearnedClause(CRef rc) {
 }
 
 bool Solver::totalModelFound() {
+	/*A*/flushDecidable();
+	/*A*/if (heuristic == heur_vmtf) return vmtf.next(assigns, decision) == var_Undef;
 	Var v = var_Undef;
 	while (v == var_Undef || assigns[v] != l_Undef || !decision[v]) {
 		if (v != var_Undef)
@@ -229,28 +427,14 @@ bool Solver::totalModelFound() {
 	return v == var_Undef;
 }
 
-struct permute{
-	int newposition;
-	Lit value;
-	permute(int newpos, Lit value): newposition(newpos), value(value){
-	}
-};
-
-struct lessthan_permute{
-	bool operator() (const permute& lhs, const permute& rhs){
-		return lhs.newposition<rhs.newposition;
-	}
-};
-
 // NOTE: do not reimplement as sort with a random comparison operator, comparison should be CONSISTENT on consecutive calls!
-void permuteRandomly(vec<Lit>& lits){
-	vector<permute> newpositions;
-	for(int i=0; i<lits.size(); ++i){
-		newpositions.push_back(permute(rand(), lits[i]));
-	}
-	std::sort(newpositions.begin(), newpositions.end(), lessthan_permute());
-	for(int i=0; i<lits.size(); ++i){
-		lits[i] = newpositions[i].value;
+// (Fisher-Yates, so no allocation and no sort per clause)
+void Solver::permuteRandomly(vec<Lit>& lits){
+	for(int i=lits.size()-1; i>0; --i){
+		int j = irand(random_seed, i+1);
+		Lit tmp = lits[i];
+		lits[i] = lits[j];
+		lits[j] = tmp;
 	}
 }
 
@@ -277,39 +461,36 @@ bool Solver::addBinaryOrLargerClause(vec<Lit>& ps, CRef& newclause) {
 
 
 
-bool Solver::addClause_(vec<Lit>& ps) {
+bool Solver::addClause_(vec<Lit>& ps/*AB*/, bool imported, int glue/*AE*/) {
+	/*AB*/
+	if (drat_file != NULL) {
+		openDratFile();
+	}
+	/*AE*/
 	if (!ok){
 		return false;
 	}
 
-	int nonfalsecount = 0;
-	if(decisionLevel()>0){
-		for(int i=0; i<ps.size() && nonfalsecount<2; ++i){
-			if(not isFalse(ps[i])){
-				nonfalsecount++;
-			}
-		}
-		if(nonfalsecount==0){
-			cancelUntil(0);
-			return addClause_(ps);
-		}
+	/*AB*/
+	if (decisionLevel() > 0) {
+		return injectClause(ps);
 	}
+	/*AE*/
 
 	sort(ps); // NOTE: remove duplicates
 
-	if(decisionLevel()==0){
-		// Check satisfaction and remove false literals
-		Lit p;
-		int i, j;
-		for (i = j = 0, p = lit_Undef; i < ps.size(); i++){
-			if (value(ps[i]) == l_True || ps[i] == ~p){
-				return true;
-			}else if (value(ps[i]) != l_False && ps[i] != p){
-				ps[j++] = p = ps[i];
-			}
+	// Check satisfaction and remove false literals
+	Lit p;
+	int i, j;
+	for (i = j = 0, p = lit_Undef; i < ps.size(); i++){
+		if (value(ps[i]) == l_True || ps[i] == ~p){
+			return true;
+		}else if (value(ps[i]) != l_False && ps[i] != p){
+			ps[j++] = p = ps[i];
 		}
-		ps.shrink(i - j);
 	}
+	ps.shrink(i - j);
+	/*A*/if (i - j > 0 && proof.isOpen()) proof.add(ps); // (the literals false at the root are propagated, so the rest follows)
 
 	// NOTE: sort randomly to reduce dependency on grounding and literal introduction mechanics (certainly for lazy grounding)
 	permuteRandomly(ps);
@@ -317,29 +498,186 @@ bool Solver::addClause_(vec<Lit>& ps) {
 	if (ps.size() == 0) {
 		return ok = false;
 	} else if (ps.size() == 1) {
-		if(decisionLevel()>0){
-			rootunitlits.push_back(ps[0]);
-		}
 		checkedEnqueue(ps[0]);
-		if(decisionLevel()==0){ // NOTE: do not do unit propagation assuming root level if it is not!
-			return ok = (propagate() == CRef_Undef);
-		}
+		return ok = (propagate() == CRef_Undef);
 	} else {
-		CRef cr = ca.alloc(ps, false);
-		addToClauses(cr, false);
+		CRef cr = ca.alloc(ps, /*A*/imported);
+		/*AB*/
+		if (imported) {
+			Clause& c = ca[cr];
+			c.glue(glue);
+			c.imported(true);
+			c.epoch(epoch);
+		}
+		/*AE*/
+		addToClauses(cr, /*A*/imported);
 		attachClause(cr);
+		/*A*/if (imported) claBumpActivity(ca[cr]);
 	}
 
 	return true;
 }
 
 /*AB*/
+// Clauses that arrive during search (e.g. from lazy grounding) keep as much of the trail as they can:
+//   - a unit is a root literal wherever it is on the trail: it is enqueued at level 0, or its level becomes 0 if it
+//     is true already. Only if it is false, the levels from the one that falsified it are undone;
+//   - a clause that is false backjumps to its assertion level (the second highest level of its literals), or one
+//     level only when backtracking chronologically, like a learnt clause, and is then propagated at that level;
+//   - a clause that is unit is propagated at the level of its false literals (see 'attachClause()').
+// The first two literals are the best watches, so 'attachClause()' does not have to look for them. Conflicts and
+// implications are thus handled right away, the caller only has to propagate.
+bool Solver::injectClause(vec<Lit>& ps) {
+	assert(decisionLevel() > 0);
+	sort(ps);
+	Lit prev = lit_Undef;
+	int size = 0;
+	for (int i = 0; i < ps.size(); i++) {
+		if (ps[i] == ~prev) {
+			return true; // (complementary literals are adjacent)
+		}
+		if (ps[i] != prev) {
+			ps[size++] = prev = ps[i];
+		}
+	}
+	ps.shrink(ps.size() - size);
+	if (size == 0) {
+		return ok = false;
+	}
+
+	if (size == 1) {
+		Lit p = ps[0];
+		if (value(p) == l_False) {
+			if (level(var(p)) == 0) {
+				return ok = false;
+			}
+			cancelUntil(level(var(p)) - 1);
+			if (decisionLevel() == 0) {
+				return addClause_(ps);
+			}
+		}
+		if (value(p) == l_Undef) {
+			uncheckedEnqueue(p, CRef_Undef, lit_Undef, 0);
+		} else if (level(var(p)) > 0) {
+			vardata[var(p)] = mkVarData(CRef_Undef, 0); // (kept by 'cancelUntil()' from now on)
+			root_epoch[var(p)] = epoch;
+		}
+		return true;
+	}
+
+	permuteRandomly(ps); // NOTE: reduce dependency on grounding and literal introduction mechanics (certainly for lazy grounding)
+
+	// The non-false literals first, then the false literals of the highest levels:
+	auto rank = [this](Lit q) { return value(q) != l_False ? INT32_MAX : level(var(q)); };
+	for (int w = 0; w < 2; w++) {
+		for (int i = w + 1; i < size; i++) {
+			if (rank(ps[i]) > rank(ps[w])) {
+				std::swap(ps[w], ps[i]);
+			}
+		}
+	}
+	if (value(ps[0]) == l_False) {
+		int top = level(var(ps[0])), assertion = level(var(ps[1]));
+		if (top == 0) {
+			return ok = false;
+		}
+		cancelUntil(top);
+		cancelUntil(assertion < top ? conflictBacktrackLevel(assertion, size) : top - 1);
+		if (decisionLevel() == 0) {
+			return addClause_(ps); // (simplified and propagated like the other clauses at the root)
+		}
+	}
+
+	CRef cr = ca.alloc(ps, false);
+	addToClauses(cr, false);
+	attachClause(cr);
+	return true;
+}
+
+// Adds the clauses like 'addClause_()' would, but in phases: all clauses are simplified against
+// the current root assignment and allocated (in arena space reserved once), then the watch lists
+// are grown to their exact new size and filled, and only then is propagated and simplified.
+bool Solver::addClauses(const vec<Lit>& lits, const vec<int>& offsets) {
+	if (drat_file != NULL) {
+		openDratFile();
+	}
+	int n = offsets.size() - 1;
+	if (decisionLevel() > 0) {
+		for (int i = 0; i < n && ok; i++) {
+			add_tmp.clear();
+			for (int k = offsets[i]; k < offsets[i + 1]; k++) {
+				add_tmp.push(lits[k]);
+			}
+			addClause_(add_tmp);
+		}
+		return ok;
+	}
+	if (!ok || n <= 0) {
+		return ok;
+	}
+
+	ca.capacity(n, lits.size());
+	clauses.capacity(clauses.size() + n);
+	int first = clauses.size();
+	for (int i = 0; i < n; i++) {
+		add_tmp.clear();
+		for (int k = offsets[i]; k < offsets[i + 1]; k++) {
+			add_tmp.push(lits[k]);
+		}
+		sort(add_tmp); // NOTE: remove duplicates
+		Lit p;
+		int k, j;
+		bool satisfied = false;
+		for (k = j = 0, p = lit_Undef; k < add_tmp.size() && not satisfied; k++) {
+			if (value(add_tmp[k]) == l_True || add_tmp[k] == ~p) {
+				satisfied = true;
+			} else if (value(add_tmp[k]) != l_False && add_tmp[k] != p) {
+				add_tmp[j++] = p = add_tmp[k];
+			}
+		}
+		if (satisfied) {
+			continue;
+		}
+		add_tmp.shrink(k - j);
+		if (k - j > 0 && proof.isOpen()) {
+			proof.add(add_tmp);
+		}
+		if (add_tmp.size() == 0) {
+			return ok = false;
+		} else if (add_tmp.size() == 1) {
+			uncheckedEnqueue(add_tmp[0]); // (propagated at the end, which also visits the clauses attached meanwhile)
+		} else {
+			permuteRandomly(add_tmp);
+			addToClauses(ca.alloc(add_tmp, false), false);
+		}
+	}
+
+	attachClauses(clauses, first);
+
+	if (propagate() != CRef_Undef) {
+		return ok = false;
+	}
+	// NOTE: only now at least one watch of each clause is not false
+	for (int i = first; i < clauses.size(); i++) {
+		checkDecisionVars(ca[clauses[i]]);
+	}
+	return simplify();
+}
+
 void Solver::addToClauses(CRef cr, bool learnt) {
 	getPCSolver().notifyClauseAdded(cr);
+	if (!searching && decisionLevel() > 0) {
+		added_above_root.push(cr);
+	}
 	if (learnt) {
-		learnts.push(cr);
+		Clause& c = ca[cr];
+		c.tier(tierOf(c.glue()));
+		c.used(true); // NOTE: gives new clauses one round in their tier before they can be demoted
+		learntsOf(c.tier()).push(cr);
 	} else {
+		ca[cr].epoch(epoch);
 		clauses.push(cr);
+		if (use_inprocess) inprocess_queue.push(cr);
 	}
 }
 
@@ -347,22 +685,39 @@ void Solver::addToClauses(CRef cr, bool learnt) {
  * Checks whether at least one watch is a decision variable.
  * If not, it randomly chooses one and makes it a decision variable
  * This guarantees that when all decision vars have been chosen, all clauses are certainly satisfied
+ * The inline 'checkDecisionVars()' already returns if both watches are decidable.
  *
- * complexity: O(1)
+ * complexity: O(1), the heap insertion and the notification are deferred until 'flushDecidable()'
  */
-void Solver::checkDecisionVars(const Clause& c) {
+void Solver::checkDecisionVars_(const Clause& c) {
 	assert(not isFalse(c[0]) || not isFalse(c[1]));
 	if(isFalse(c[0])){
-		setDecidable(var(c[1]), true);
+		makeDecidable(var(c[1]));
 	}else if(isFalse(c[1])){
-		setDecidable(var(c[0]), true);
+		makeDecidable(var(c[0]));
 	}else if (not isDecisionVar(var(c[0])) && not isDecisionVar(var(c[1]))) {
 		int choice = irand(random_seed, 2);
 		assert(choice==0 || choice==1);
-		setDecidable(var(c[choice]), true);
+		makeDecidable(var(c[choice]));
 	}
 	assert((not isFalse(c[0]) && isDecisionVar(var(c[0]))) || (not isFalse(c[1]) && isDecisionVar(var(c[1]))));
 }
+
+// NOTE: notifying PCSolver can make new variables pending, which are then handled in the same call.
+void Solver::flushDecidable() {
+	for (int i = 0; i < pending_decidable.size(); i++) {
+		Var v = pending_decidable[i];
+		if (not decision[v]) { // Made undecidable again in the meantime
+			continue;
+		}
+		if (verbosity > 10) {
+			clog << ">>> Making " << mkPosLit(v) << " decidable.\n";
+		}
+		insertVarOrder(v);
+		getPCSolver().notifyBecameDecidable(v);
+	}
+	pending_decidable.clear();
+}
 /*AE*/
 
 void swap(Clause& c, int from, int to){
@@ -376,7 +731,7 @@ void Solver::attachClause(CRef cr) {
 	auto& c = ca[cr];
 	assert(c.size() > 1);
 
-	if(decisionLevel()>0 && not c.learnt()){ // If Level > 0 and an input clause, reorder the watches so the first two are unknown or the most recently chosen ones
+	if(decisionLevel()>0 && not c.learnt() /*A*/&& (isFalse(c[0]) || isFalse(c[1]))){ // If Level > 0 and an input clause, reorder the watches so the first two are unknown or the most recently chosen ones
 		int firstnonfalseindex = -1, secondnonfalseindex = -1, mostrecentfalseindex = -1, mostrecentfalselevel = -1;
 		for(int i=0; i<c.size(); ++i){
 			if(isFalse(c[i])){
@@ -409,7 +764,7 @@ void Solver::attachClause(CRef cr) {
 			swap(c, mostrecentfalseindex, 1);
 			MAssert(isFalse(c[1]));
 			if(not isTrue(c[0])){ // NOTE: important! The watch has already fired, so otherwise it would be lost!
-				uncheckedEnqueue(c[0], cr);
+				/*A*/enqueueUnit(cr);
 			}
 		}
 	}
@@ -417,8 +772,15 @@ void Solver::attachClause(CRef cr) {
 	if(not c.learnt()){
 		assert(not isFalse(c[1]) || not isFalse(c[0]));
 	}
-	watches[~c[0]].push(Watcher(cr, c[1]));
-	watches[~c[1]].push(Watcher(cr, c[0]));
+	/*AB*/
+	if(c.size()==2){
+		binwatches[~c[0]].push(BinWatcher(cr, c[1]));
+		binwatches[~c[1]].push(BinWatcher(cr, c[0]));
+	}else{
+	/*AE*/
+		watches[~c[0]].push(Watcher(cr, c[1]));
+		watches[~c[1]].push(Watcher(cr, c[0]));
+	/*A*/}
 	if (c.learnt())
 		learnts_literals += c.size();
 	else
@@ -432,6 +794,44 @@ void Solver::attachClause(CRef cr) {
 	/*AE*/
 }
 
+/*AB*/
+// Counts the new watchers per literal first, so every list grows once to its exact size:
+void Solver::attachClauses(const vec<CRef>& cs, int first) {
+	assert(decisionLevel() == 0);
+	vec<int> counts(2 * nVars(), 0), bincounts(2 * nVars(), 0);
+	for (int i = first; i < cs.size(); i++) {
+		const Clause& c = ca[cs[i]];
+		vec<int>& ct = c.size() == 2 ? bincounts : counts;
+		ct[toInt(~c[0])]++;
+		ct[toInt(~c[1])]++;
+	}
+	for (int l = 0; l < 2 * nVars(); l++) {
+		Lit lit = toLit(l);
+		if (counts[l] > 0) {
+			watches[lit].capacity(watches[lit].size() + counts[l]);
+		}
+		if (bincounts[l] > 0) {
+			binwatches[lit].capacity(binwatches[lit].size() + bincounts[l]);
+		}
+	}
+	for (int i = first; i < cs.size(); i++) {
+		CRef cr = cs[i];
+		const Clause& c = ca[cr];
+		if (c.size() == 2) {
+			binwatches[~c[0]].push(BinWatcher(cr, c[1]));
+			binwatches[~c[1]].push(BinWatcher(cr, c[0]));
+		} else {
+			watches[~c[0]].push(Watcher(cr, c[1]));
+			watches[~c[1]].push(Watcher(cr, c[0]));
+		}
+		if (c.learnt())
+			learnts_literals += c.size();
+		else
+			clauses_literals += c.size();
+	}
+}
+/*AE*/
+
 void Solver::detachClause(CRef cr, bool strict) {
 	const Clause& c = ca[cr];
 	if (c.size() < 2) {
@@ -439,6 +839,17 @@ void Solver::detachClause(CRef cr, bool strict) {
 		std::clog << "clausesize: " << c.size() << "\n";
 	}assert(c.size() > 1);
 
+	/*AB*/
+	if (c.size() == 2) {
+		if (strict) {
+			remove(binwatches[~c[0]], BinWatcher(cr, c[1]));
+			remove(binwatches[~c[1]], BinWatcher(cr, c[0]));
+		} else {
+			binwatches.smudge(~c[0]);
+			binwatches.smudge(~c[1]);
+		}
+	} else
+	/*AE*/
 	if (strict) {
 		remove(watches[~c[0]], Watcher(cr, c[1]));
 		remove(watches[~c[1]], Watcher(cr, c[0]));
@@ -456,36 +867,185 @@ void Solver::detachClause(CRef cr, bool strict) {
 
 /*AB*/
 void Solver::saveState() {
-	savedok = ok;
-	savedlevel = decisionLevel();
-	savedclausessize = clauses.size();
-	remove_satisfied = false;
-	savedqhead = qhead;
-	trail_lim.copyTo(savedtraillim);
-	trail.copyTo(savedtrail);
+	while (checkpoints.size() > 0) {
+		popCheckpoint();
+	}
+	pushCheckpoint();
 }
 
 void Solver::resetState() {
-	//FIXME is this correct and sufficient?
-	ok = savedok;
-	cancelUntil(savedlevel);
-	qhead = savedqhead;
-	trail.clear();
-	savedtrail.copyTo(trail);
-	trail_lim.clear();
-	savedtraillim.copyTo(trail_lim);
-
-	//Remove new clauses
-	for (int i = savedclausessize; i < clauses.size(); i++) {
+	assert(checkpoints.size() > 0);
+	rollbackCheckpoint();
+}
+
+int Solver::pushCheckpoint() {
+	if (epoch >= (uint32_t) Clause::Epoch_Max) {
+		renumberEpochs();
+	}
+	epoch++;
+
+	checkpoints.push();
+	Checkpoint& cp = checkpoints.last();
+	cp.epoch = epoch;
+	cp.ok = ok;
+	cp.remove_satisfied = remove_satisfied;
+	cp.level = decisionLevel();
+	cp.trail_size = trail.size();
+	cp.qhead = qhead;
+	cp.clauses_size = clauses.size();
+	cp.intact_level = cp.level;
+	cp.intact_trail = cp.trail_size;
+	cp.decisions.clear();
+	cp.rootunits.clear();
+	for (auto i = rootunitlits.cbegin(); i < rootunitlits.cend(); ++i) {
+		cp.rootunits.push(*i);
+	}
+	for (int i = decisionLevel() > 0 ? trail_lim[0] : trail.size(); i < trail.size(); i++) {
+		if (level(var(trail[i])) == 0) { // (added above the root, see 'injectClause()': they might come after 'intact_trail' later)
+			cp.rootunits.push(trail[i]);
+		}
+	}
+
+	remove_satisfied = false; // NOTE: satisfied problem clauses might be needed again after a rollback
+	return checkpoints.size();
+}
+
+void Solver::popCheckpoint() {
+	assert(checkpoints.size() > 0);
+	bool rs = checkpoints.last().remove_satisfied;
+	checkpoints.pop();
+	if (checkpoints.size() == 0) {
+		remove_satisfied = rs;
+	}
+}
+
+// Saves the decisions of the levels that are about to be undone, for the checkpoints that still need them.
+// Each level is saved at most once per checkpoint, so the total cost is bounded by the number of levels.
+void Solver::recordUndoneLevels(int level) {
+	for (int i = 0; i < checkpoints.size(); i++) {
+		Checkpoint& cp = checkpoints[i];
+		if (cp.intact_level <= level) {
+			continue;
+		}
+		cp.decisions.growTo(cp.level, lit_Undef);
+		for (int l = level; l < cp.intact_level; l++) {
+			int end = l + 1 < trail_lim.size() ? trail_lim[l + 1] : trail.size();
+			cp.decisions[l] = trail_lim[l] < end ? trail[trail_lim[l]] : lit_Undef; // NOTE: lit_Undef for a dummy decision level
+		}
+		cp.intact_level = level;
+		cp.intact_trail = trail_lim[level];
+	}
+}
+
+void Solver::rollbackCheckpoint() {
+	assert(checkpoints.size() > 0);
+	Checkpoint& cp = checkpoints.last();
+
+	ok = cp.ok;
+
+	// Undo the assignments made after the checkpoint, without notifying the other propagators (PCSolver resets their state):
+	cancelUntil(cp.intact_level);
+	bool undone = cp.intact_level < cp.level || trail.size() < cp.trail_size;
+	for (int c = trail.size() - 1; c >= cp.intact_trail; c--) {
+		Var x = var(trail[c]);
+		assigns[x] = l_Undef;
+		insertVarOrder(x);
+	}
+	if (trail.size() > cp.intact_trail) {
+		trail.shrink(trail.size() - cp.intact_trail);
+	}
+	clampTrailHeads();
+	/*A*/if (export_roots > trail.size()) export_roots = trail.size();
+	for (int i = 0; i < checkpoints.size(); i++) {
+		if (checkpoints[i].intact_trail > trail.size()) {
+			checkpoints[i].intact_trail = trail.size();
+		}
+	}
+	qhead = undone ? trail.size() : cp.qhead;
+
+	rootunitlits.clear();
+	for (int i = 0; i < cp.rootunits.size(); i++) {
+		rootunitlits.push_back(cp.rootunits[i]);
+	}
+
+	// Remove the new clauses and the learnt clauses that (might) depend on them:
+	for (int i = cp.clauses_size; i < clauses.size(); i++) {
 		removeClause(clauses[i]);
 	}
-	clauses.shrink(savedclausessize);
+	clauses.shrink(clauses.size() - cp.clauses_size);
+	/*A*/if (export_clauses > clauses.size()) export_clauses = clauses.size();
+
+	for (int t = tier_core; t <= tier_local; t++) {
+		vec<CRef>& ls = learntsOf(t);
+		int i, j;
+		for (i = j = 0; i < ls.size(); i++) {
+			if (ca[ls[i]].epoch() >= cp.epoch)
+				removeClause(ls[i]);
+			else
+				ls[j++] = ls[i];
+		}
+		ls.shrink(i - j);
+	}
+
+	// Redo the decisions of the levels that were undone since the checkpoint:
+	for (int l = cp.intact_level; l < cp.level; l++) {
+		Lit d = cp.decisions[l];
+		if (d != lit_Undef && value(d) == l_False) {
+			break;
+		}
+		createNewDecisionLevel();
+		if (d != lit_Undef && value(d) == l_Undef) {
+			uncheckedEnqueue(d);
+		}
+		if (propagate() != CRef_Undef) { // NOTE: the remaining levels are lost, the checkpoint now restores to the last consistent one
+			cancelUntil(decisionLevel() - 1);
+			break;
+		}
+	}
+
+	// The current state is now what the checkpoint restores to:
+	cp.level = decisionLevel();
+	cp.trail_size = trail.size();
+	cp.qhead = qhead;
+	cp.intact_level = cp.level;
+	cp.intact_trail = cp.trail_size;
+	cp.decisions.clear();
+	checkGarbage();
+}
+
+// Maps every epoch to the number of checkpoints opened at or before it, which keeps all comparisons with
+// the epochs of the open checkpoints intact.
+void Solver::renumberEpochs() {
+	struct Renumber {
+		const vec<Checkpoint>& cps;
+		explicit Renumber(const vec<Checkpoint>& c) : cps(c) {}
+		uint32_t operator()(uint32_t e) const {
+			int k = 0;
+			while (k < cps.size() && cps[k].epoch <= e) {
+				k++;
+			}
+			return k;
+		}
+	} renumber(checkpoints);
 
-	//Remove learned clauses //TODO only forgetting the new learned clauses would also do and be better for learning!
-	for (int i = 0; i < learnts.size(); i++) {
-		removeClause(learnts[i]);
+	for (int i = 0; i < clauses.size(); i++) {
+		Clause& c = ca[clauses[i]];
+		c.epoch(renumber(c.epoch()));
+	}
+	for (int t = tier_core; t <= tier_local; t++) {
+		vec<CRef>& ls = learntsOf(t);
+		for (int i = 0; i < ls.size(); i++) {
+			Clause& c = ca[ls[i]];
+			c.epoch(renumber(c.epoch()));
+		}
+	}
+	for (int v = 0; v < nVars(); v++) {
+		root_epoch[v] = renumber(root_epoch[v]);
 	}
-	learnts.clear();
+	for (int i = 0; i < checkpoints.size(); i++) {
+		checkpoints[i].epoch = i + 1;
+	}
+	epoch = checkpoints.size();
 }
 /*AE*/
 
@@ -493,8 +1053,20 @@ void Solver::removeClause(CRef cr) {
 	Clause& c = ca[cr];
 	detachClause(cr);
 	// Don't leave pointers to free'd memory!
-	if (locked(c))
-		vardata[var(c[0])].reason = CRef_Undef;
+	/*AB*/
+	for (int i = 0; i < (c.size() == 2 ? 2 : 1); i++) {
+		if (lockedBy(c, c[i])) {
+			if (proof.isOpen() && level(var(c[i])) == 0) {
+				proof.add(c[i]); // (so that the proof does not depend on the checker remembering the root assignment)
+			}
+			vardata[var(c[i])].reason = CRef_Undef;
+			vardata[var(c[i])].binother = lit_Undef;
+		}
+	}
+	if (proof.isOpen()) {
+		proof.remove(c);
+	}
+	/*AE*/
 	c.mark(1);
 	ca.free(cr);
 }
@@ -507,6 +1079,8 @@ bool Solver::satisfied(const Clause& c) const {
 }
 
 // Revert to the state at given level (keeping all assignment at 'level' but not beyond).
+// NOTE: after chronological backtracking, the trail can contain literals of a lower level than the one they are in. These
+// are kept, pushed again after the other propagators backtracked (so they are notified of them again) and propagated again.
 //
 void Solver::cancelUntil(int level) {
 	if(verbosity>8){
@@ -514,21 +1088,37 @@ void Solver::cancelUntil(int level) {
 	}
 	if (decisionLevel() > level) {
 		/*A*/fullassignment = false;
+		/*A*/if (checkpoints.size() > 0) recordUndoneLevels(level);
 		/*A*/
-		Lit decision = trail[trail_lim[level]];
+		Lit decision = /*A*/trail_lim[level] < trail.size() ? trail[trail_lim[level]] : lit_Undef; // (a dummy level of an assumption that was already true can be empty)
+		/*A*/cancel_kept.clear();
 		for (int c = trail.size() - 1; c >= trail_lim[level]; c--) {
 			Var x = var(trail[c]);
+			/*AB*/
+			if (vardata[x].level <= level) {
+				cancel_kept.push(trail[c]);
+				continue;
+			}
+			/*AE*/
 			assigns[x] = l_Undef;
 			if (phase_saving > 1 || ((phase_saving == 1) && c > trail_lim.last()))
 				polarity[x] = sign(trail[c]);
+			/*A*/if (heuristic == heur_chb) chbReward(x);
 			insertVarOrder(x);
 		}
 		qhead = trail_lim[level];
 		trail.shrink(trail.size() - trail_lim[level]);
+		/*A*/clampTrailHeads();
 		/*AB*/
 		int levels = trail_lim.size() - level;
 		trail_lim.shrink(levels);
 		getPCSolver().backtrackDecisionLevel(level, decision);
+		for (int i = cancel_kept.size() - 1; i >= 0; i--) {
+			trail.push_(cancel_kept[i]);
+			if (not batched_notify) {
+				getPCSolver().notifySetTrue(cancel_kept[i]);
+			}
+		}
 		/*AE*/
 	}
 	for(auto i=rootunitlits.cbegin(); i<rootunitlits.cend(); ++i){
@@ -551,8 +1141,19 @@ void Solver::cancelUntil(int level) {
 
 Lit Solver::pickBranchLit() {
 	Var next = var_Undef;
+	/*A*/flushDecidable();
 
 	// Random decision:
+	/*AB*/
+	if (heuristic == heur_vmtf) {
+		if (drand(random_seed) < random_var_freq && nVars() > 0) {
+			next = irand(random_seed, nVars());
+			if (value(next) == l_Undef && decision[next]) {
+				rnd_decisions++;
+			}
+		}
+	} else
+	/*AE*/
 	if (drand(random_seed) < random_var_freq && !order_heap.empty()) {
 		next = order_heap[irand(random_seed, order_heap.size())];
 		if (value(next) == l_Undef && decision[next]) {
@@ -562,6 +1163,13 @@ Lit Solver::pickBranchLit() {
 
 	// Activity based decision:
 	bool start = true;
+	/*AB*/
+	if (heuristic == heur_vmtf) {
+		if (next == var_Undef || value(next) != l_Undef || !decision[next]) {
+			next = vmtf.next(assigns, decision);
+		}
+	} else
+	/*AE*/
 	while (next == var_Undef || value(next) != l_Undef || !decision[next]) {
 		if (!start) { // So then remove it if it proved redundant
 			order_heap.removeMin();
@@ -599,6 +1207,10 @@ Lit Solver::pickBranchLit() {
 		return mkLit(next, user_pol[next] == l_True);
 	} else if (rnd_pol){
 		return mkLit(next, drand(random_seed) < 0.5);
+	/*AB*/
+	} else if (target_phase[next] != l_Undef && targetPhases()){
+		return mkLit(next, target_phase[next] == l_True);
+	/*AE*/
 	} else{
 		return mkLit(next, polarity[next]);
 	}
@@ -606,7 +1218,7 @@ Lit Solver::pickBranchLit() {
 
 /*_________________________________________________________________________________________________
  |
- |  analyze : (confl : Clause*) (out_learnt : vec<Lit>&) (out_btlevel : int&)  ->  [void]
+ |  analyze : (confl : Clause*) (out_learnt : vec<Lit>&) (out_btlevel : int&) (out_glue : int&)  ->  [void]
  |
  |  Description:
  |    Analyze conflict and produce a reason clause.
@@ -617,6 +1229,7 @@ Lit Solver::pickBranchLit() {
  |
  |    Post-conditions:
  |      * 'out_learnt[0]' is the asserting literal at level 'out_btlevel'.
+ |      * 'out_glue' is the literal block distance of 'out_learnt'.
  |      * If out_learnt.size() > 1 then 'out_learnt[1]' has the greatest decision level of the
  |        rest of literals. There may be others from the same level though.
  |
@@ -625,21 +1238,15 @@ bool Solver::isAlreadyUsedInAnalyze(const Lit& lit) const {
 	return seen[var(lit)] == 1;
 }
 
-void Solver::analyze(CRef confl, vec<Lit>& out_learnt, int& out_btlevel) {
+void Solver::analyze(CRef confl, vec<Lit>& out_learnt, int& out_btlevel, int& out_glue) {
+	/*A*/StatTimer timer(stats, st_analyze);
 	int pathC = 0;
 	Lit p = lit_Undef;
 
 	/*AB VERY IMPORTANT*/
-	int lvl = 0;
-	Clause& c = ca[confl];
-	for (int i = 0; i < c.size(); i++) {
-		int litlevel = level(var(c[i]));
-		if (litlevel > lvl) {
-			lvl = litlevel;
-		}
-	}
+	int lvl = conflictLevel(confl);
 
-	assert(lvl<=decisionLevel());
+	assert(lvl > 0 && lvl<=decisionLevel());
 
 	cancelUntil(lvl);
 
@@ -648,6 +1255,10 @@ void Solver::analyze(CRef confl, vec<Lit>& out_learnt, int& out_btlevel) {
 
 	//reportf("Conflicts: %d.\n", conflicts);
 	std::vector<Lit> explain;
+
+	// Only needed to decide which learnt clauses survive a rollback:
+	bool trackepochs = checkpoints.size() > 0;
+	analyze_epoch = 0;
 	/*AE*/
 
 	// Generate conflict clause:
@@ -657,10 +1268,10 @@ void Solver::analyze(CRef confl, vec<Lit>& out_learnt, int& out_btlevel) {
 
 	/*A*/
 	bool deleteImplicitClause = false;
+	/*A*/Lit binother = lit_Undef; // Set if 'confl' is the binary reason of 'p', which is then not looked up in the arena.
 	do {
 		assert(confl != CRef_Undef);
 		// (otherwise should be UIP)
-		Clause& c = ca[confl];
 
 		/*AB*/
 		if (verbosity > 4) {
@@ -677,11 +1288,34 @@ void Solver::analyze(CRef confl, vec<Lit>& out_learnt, int& out_btlevel) {
 		}
 		/*AE*/
 
-		if (c.learnt())
-			claBumpActivity(c);
+		/*AB*/
+		const Lit* lits;
+		int nlits;
+		if (binother != lit_Undef) {
+			lits = &binother;
+			nlits = 1;
+			if (trackepochs) dependsOn(ca[confl]);
+			if (exchange != NULL) noteUsedImport(ca[confl]);
+		} else {
+			Clause& c = ca[confl];
+			stats.add(st_clause_derefs);
+			if (trackepochs) dependsOn(c);
+			if (c.learnt()) {
+				claBumpActivity(c);
+				updateGlue(c);
+				noteUsedImport(c);
+			}
+			int start = (p == lit_Undef) ? 0 : 1;
+			lits = (const Lit*) c + start;
+			nlits = c.size() - start;
+		}
+		/*AE*/
 
-		for (int j = (p == lit_Undef) ? 0 : 1; j < c.size(); j++) {
-			Lit q = c[j];
+		/*A*/int nonroot = 0;
+		/*A*/ticks += 1 + nlits;
+		for (int j = 0; j < nlits; j++) {
+			Lit q = lits[j];
+			/*A*/nonroot += level(var(q)) > 0;
 
 			if (!seen[var(q)] && level(var(q)) > 0) {
 				varBumpActivity(var(q));
@@ -691,9 +1325,18 @@ void Solver::analyze(CRef confl, vec<Lit>& out_learnt, int& out_btlevel) {
 				else
 					out_learnt.push(q);
 			}
+			/*A*/else if (trackepochs && level(var(q)) == 0) dependsOnRoot(var(q));
 		}
 
 		/*AB*/
+		// On-the-fly subsumption: if the resolvent consists of the other literals of the reason of 'p' (and at least two of
+		// them are of this level), 'p' can be removed from that reason. This is done after backtracking, see 'strengthenAntecedents()'.
+		// NOTE: clauses that can be rolled back must not strengthen others, so not while there are checkpoints.
+		if (otfs && p != lit_Undef && binother == lit_Undef && not deleteImplicitClause && not trackepochs && pathC > 1
+				&& ca[confl].learnt() && nonroot == pathC + out_learnt.size() - 1) {
+			strengthen_queue.push(confl);
+		}
+
 		if (verbosity > 4) {
 			for (auto i = explain.begin(); i < explain.end(); i++) {
 				clog << *i << " ";
@@ -708,10 +1351,12 @@ void Solver::analyze(CRef confl, vec<Lit>& out_learnt, int& out_btlevel) {
 		/*AE*/
 
 		// Select next clause to look at:
-		while (!seen[var(trail[index--])])
+		// NOTE: literals of a lower level can be on the trail after chronological backtracking
+		while (!seen[var(trail[index--])] || level(var(trail[index + 1])) < decisionLevel())
 			;
 		p = trail[index + 1];
 		confl = reason(var(p));
+		/*A*/binother = binaryReason(var(p));
 
 		/*AB*/
 		if (verbosity > 4) {
@@ -740,11 +1385,14 @@ void Solver::analyze(CRef confl, vec<Lit>& out_learnt, int& out_btlevel) {
 			if(delayedroot){
 				InnerDisjunction d;
 				d.literals = {p};
+				StatTimer callback(stats, st_callbacks);
 				confl = getPCSolver().createClause(d, true);
 			}else{
+				StatTimer callback(stats, st_callbacks);
 				confl = getPCSolver().getExplanation(p);
 				deleteImplicitClause = true;
 			}
+			analyze_epoch = epoch; // NOTE: explanations of other propagators can depend on anything added so far
 		}
 		if (verbosity > 4 && confl != CRef_Undef) {
 			reportf("Explanation is ");
@@ -779,12 +1427,23 @@ void Solver::analyze(CRef confl, vec<Lit>& out_learnt, int& out_btlevel) {
 			if (reason(x) == CRef_Undef)
 				out_learnt[j++] = out_learnt[i];
 			else {
-				Clause& c = ca[reason(var(out_learnt[i]))];
-				for (int k = 1; k < c.size(); k++)
-					if (!seen[var(c[k])] && level(var(c[k])) > 0) {
+				const Lit* lits;
+				int nlits;
+				reasonLits(x, lits, nlits);
+				int k;
+				for (k = 0; k < nlits; k++)
+					if (!seen[var(lits[k])] && level(var(lits[k])) > 0) {
 						out_learnt[j++] = out_learnt[i];
 						break;
 					}
+				/*AB*/
+				if (trackepochs && k == nlits) { // 'x' was removed, so the learnt clause also depends on its reason
+					dependsOn(ca[reason(x)]);
+					for (k = 0; k < nlits; k++)
+						if (level(var(lits[k])) == 0)
+							dependsOnRoot(var(lits[k]));
+				}
+				/*AE*/
 			}
 		}
 	} else
@@ -792,6 +1451,7 @@ void Solver::analyze(CRef confl, vec<Lit>& out_learnt, int& out_btlevel) {
 
 	max_literals += out_learnt.size();
 	out_learnt.shrink(i - j);
+	/*A*/if (bin_min > 0 && out_learnt.size() > 2 && computeLBD(out_learnt) <= bin_min) minimizeBinary(out_learnt);
 	tot_literals += out_learnt.size();
 
 	// Find correct backtrack level:
@@ -810,6 +1470,7 @@ void Solver::analyze(CRef confl, vec<Lit>& out_learnt, int& out_btlevel) {
 		out_learnt[1] = p;
 		out_btlevel = level(var(p));
 	}
+	/*A*/out_glue = computeLBD(out_learnt);
 
 	for (int j = 0; j < analyze_toclear.size(); j++)
 		seen[var(analyze_toclear[j])] = 0; // ('seen[]' is now cleared)
@@ -817,19 +1478,83 @@ void Solver::analyze(CRef confl, vec<Lit>& out_learnt, int& out_btlevel) {
 	/*A*/
 }
 
+/*AB*/
+// Remove the literals 'l' of 'out_learnt' for which a binary clause '(out_learnt[0] | ~l)' exists, as resolving with it
+// gives a subset of 'out_learnt'. Pre-condition: 'seen[]' is set for the literals of 'out_learnt' (and cleared by 'analyze()').
+void Solver::minimizeBinary(vec<Lit>& out_learnt) {
+	for (int i = 1; i < out_learnt.size(); i++)
+		seen[var(out_learnt[i])] = 2;
+
+	int removed = 0;
+	const vec<BinWatcher>& bws = binwatches[~out_learnt[0]];
+	for (int k = 0; k < bws.size(); k++) {
+		Lit imp = bws[k].implied;
+		if (seen[var(imp)] == 2 && value(imp) == l_True && ca[bws[k].cref].mark() == 0) {
+			seen[var(imp)] = 1;
+			removed++;
+			if (checkpoints.size() > 0) dependsOn(ca[bws[k].cref]);
+		}
+	}
+	if (removed == 0)
+		return;
+
+	int i, j;
+	for (i = j = 1; i < out_learnt.size(); i++)
+		if (seen[var(out_learnt[i])] == 2)
+			out_learnt[j++] = out_learnt[i];
+	out_learnt.shrink(i - j);
+	bin_minimized += removed;
+}
+
+// Remove the implied literal from the reasons that 'analyze()' found to be subsumed by an intermediate resolvent. Must
+// be called after backtracking, when that literal and at least two others of each of these clauses are unassigned.
+void Solver::strengthenAntecedents() {
+	for (int i = 0; i < strengthen_queue.size(); i++) {
+		CRef cr = strengthen_queue[i];
+		Clause& c = ca[cr];
+		int nundef = 0;
+		for (int k = 1; k < c.size() && nundef < 2; k++)
+			if (value(c[k]) == l_Undef)
+				nundef++;
+		if (c.mark() != 0 || value(c[0]) != l_Undef || nundef < 2)
+			continue;
+
+		detachClause(cr, true);
+		Lit p = c[0];
+		c.strengthen(p);
+		if (proof.isOpen()) {
+			proof.add(c);
+			proof.remove(c, p);
+		}
+		for (int k = 0, w = 0; k < c.size() && w < 2; k++) // (watch two unassigned literals)
+			if (value(c[k]) == l_Undef)
+				swap(c, k, w++);
+		attachClause(cr);
+		otf_strengthened++;
+	}
+	strengthen_queue.clear();
+}
+/*AE*/
+
 // Check if 'p' can be removed. 'abstract_levels' is used to abort early if the algorithm is
 // visiting literals at levels that cannot be removed later.
 bool Solver::litRedundant(Lit p, uint32_t abstract_levels) {
+	/*A*/StatTimer timer(stats, st_litredundant);
 	analyze_stack.clear();
 	analyze_stack.push(p);
 	int top = analyze_toclear.size();
 	while (analyze_stack.size() > 0) {
 		assert(reason(var(analyze_stack.last())) != CRef_Undef);
-		Clause& c = ca[reason(var(analyze_stack.last()))];
+		const Lit* lits;
+		int nlits;
+		reasonLits(var(analyze_stack.last()), lits, nlits);
+		/*A*/ticks += 1 + nlits;
+		/*A*/if (checkpoints.size() > 0) dependsOn(ca[reason(var(analyze_stack.last()))]); // NOTE: conservative, also when 'p' turns out not to be redundant
 		analyze_stack.pop();
 
-		for (int i = 1; i < c.size(); i++) {
-			Lit p = c[i];
+		for (int i = 0; i < nlits; i++) {
+			Lit p = lits[i];
+			/*A*/if (checkpoints.size() > 0 && level(var(p)) == 0) dependsOnRoot(var(p));
 			if (!seen[var(p)] && level(var(p)) > 0) {
 				if (reason(var(p)) != CRef_Undef && (abstractLevel(var(p)) & abstract_levels) != 0) {
 					seen[var(p)] = 1;
@@ -861,7 +1586,7 @@ void Solver::analyzeFinal(Lit p, vec<Lit>& out_conflict) {
 	out_conflict.clear();
 	out_conflict.push(p);
 
-	if (decisionLevel() == 0)
+	if (decisionLevel() == 0 /*A*/|| level(var(p)) == 0)
 		return;
 
 	seen[var(p)] = 1;
@@ -873,10 +1598,12 @@ void Solver::analyzeFinal(Lit p, vec<Lit>& out_conflict) {
 				assert(level(x) > 0);
 				out_conflict.push(~trail[i]);
 			} else {
-				Clause& c = ca[reason(x)];
-				for (int j = 1; j < c.size(); j++)
-					if (level(var(c[j])) > 0)
-						seen[var(c[j])] = 1;
+				const Lit* lits;
+				int nlits;
+				reasonLits(x, lits, nlits);
+				for (int j = 0; j < nlits; j++)
+					if (level(var(lits[j])) > 0)
+						seen[var(lits[j])] = 1;
 			}
 			seen[x] = 0;
 		}
@@ -891,16 +1618,22 @@ void Solver::checkedEnqueue(Lit p, CRef from) {
 	}
 }
 
-void Solver::uncheckedEnqueue(Lit p, CRef from) {
+void Solver::uncheckedEnqueue(Lit p, CRef from, Lit binother, int lvl) {
 	assert(value(p) == l_Undef);
+	assert(binother == lit_Undef || from != CRef_Undef);
+	/*A*/if (lvl < 0) lvl = decisionLevel();
+	assert(lvl <= decisionLevel());
 	assigns[var(p)] = lbool(!sign(p));
-	vardata[var(p)] = mkVarData(from, decisionLevel());
+	vardata[var(p)] = mkVarData(from, binother, lvl);
 	trail.push_(p);
 	/*A*/
-	if(not isDecisionVar(var(p))){
-		setDecidable(var(p), true);
+	if(lvl==0){
+		root_epoch[var(p)] = epoch;
+	}
+	makeDecidable(var(p));
+	if (not batched_notify) {
+		getPCSolver().notifySetTrue(p);
 	}
-	getPCSolver().notifySetTrue(p);
 	/*A*/if (verbosity > 3) {
 		getPCSolver().printEnqueued(p);
 	}
@@ -918,28 +1651,111 @@ void Solver::uncheckedEnqueue(Lit p, CRef from) {
  |      * the propagation queue is empty, even if there was a conflict.
  |________________________________________________________________________________________________@*/
 CRef Solver::propagate() {
+	/*A*/StatTimer timer(stats, st_propagate);
 	return getPCSolver().propagate();
 }
 
+/*AB*/
+// Binary reasons are stored as the false literal, but clients expect the implied literal first.
+CRef Solver::getExplanation(const Lit& l) {
+	CRef cr = reason(var(l));
+	if (cr != CRef_Undef && binaryReason(var(l)) != lit_Undef) {
+		Clause& c = ca[cr];
+		if (c[0] != l) {
+			c[1] = c[0];
+			c[0] = l;
+		}
+	}
+	return cr;
+}
+/*AE*/
+
+/*AB*/
+// The first literal of 'lits[from..to)' that is not false ('to' if there is none). With AVX2, eight
+// literals are tested at a time, their values are gathered from 'assigns':
+static inline int firstNonFalse(const Lit* lits, int from, int to, const lbool* assigns) {
+	int k = from;
+#ifdef __AVX2__
+	static_assert(sizeof(lbool) == 1 && sizeof(Lit) == 4, "the values are gathered as bytes, by literal");
+	const __m256i one = _mm256_set1_epi32(1), byte = _mm256_set1_epi32(0xFF);
+	for (; k + 8 <= to; k += 8) {
+		__m256i ls = _mm256_loadu_si256((const __m256i*) (lits + k));
+		__m256i vs = _mm256_i32gather_epi32((const int*) assigns, _mm256_srli_epi32(ls, 1), 1); // (bytes 'var' to 'var+3')
+		vs = _mm256_xor_si256(_mm256_and_si256(vs, byte), _mm256_and_si256(ls, one)); // (as 'value(Lit)', 1 is false)
+		int nonfalse = ~_mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpeq_epi32(vs, one))) & 0xFF;
+		if (nonfalse != 0) {
+			return k + __builtin_ctz(nonfalse);
+		}
+	}
+#endif
+	for (; k < to; k++) {
+		if ((assigns[var(lits[k])] ^ sign(lits[k])) != l_False) {
+			return k;
+		}
+	}
+	return to;
+}
+
+static inline void prefetch(const void* p) {
+#if defined(__GNUC__)
+	__builtin_prefetch(p);
+#endif
+}
+/*AE*/
+
 CRef Solver::notifypropagate() {
+	/*A*/StatTimer timer(stats, st_notifypropagate);
 	CRef confl = CRef_Undef;
 	int num_props = 0;
+	/*A*/uint64_t visits = 0, blocker_hits = 0, scanned = 0; // (counted locally, they are added to 'stats' and 'ticks' once)
 	watches.cleanAll();
+	/*A*/binwatches.cleanAll();
 
 	while (qhead < trail.size()) {
 		Lit p = trail[qhead++]; // 'p' is enqueued fact to propagate.
-		vec<Watcher>& ws = watches[p];
-		Watcher *i, *j, *end;
 		num_props++;
 
-		for (i = j = (Watcher*) ws, end = i + ws.size(); i != end;) {
-			// Try to avoid inspecting the clause:
-			// FIXME do not understand blocker code yet, so commented it
-			Lit blocker = i->blocker;
-			if (value(blocker) == l_True) {
-				setDecidable(var(blocker), true); // TODO is this the best possible call?
-				*j++ = *i++;
-				continue;
+		/*AB*/
+		// Propagate binary clauses first, they are handled without touching the clause arena:
+		vec<BinWatcher>& bws = binwatches[p];
+		scanned += bws.size();
+		for (int k = 0; k < bws.size(); k++) {
+			Lit implied = bws[k].implied;
+			lbool val = value(implied);
+			if (val == l_True) {
+				makeDecidable(var(implied));
+			} else if (val == l_False) {
+				confl = bws[k].cref;
+				break;
+			} else {
+				uncheckedEnqueue(implied, bws[k].cref, ~p);
+			}
+		}
+		if (confl != CRef_Undef) {
+			qhead = trail.size();
+			break;
+		}
+		/*AE*/
+
+		vec<Watcher>& ws = watches[p];
+		Watcher *i, *j, *end;
+
+		for (i = j = (Watcher*) ws, end = i + ws.size(); i != end;) {
+			/*A*/visits++;
+			/*AB*/
+			// The clause of a watcher further on is fetched while this one is handled (testing its blocker first costs more than it saves):
+			if (end - i > prefetch_distance) {
+				prefetch(ca.lea(i[prefetch_distance].cref));
+			}
+			/*AE*/
+			// Try to avoid inspecting the clause:
+			// FIXME do not understand blocker code yet, so commented it
+			Lit blocker = i->blocker;
+			if (value(blocker) == l_True) {
+				/*A*/blocker_hits++;
+				makeDecidable(var(blocker)); // TODO is this the best possible call?
+				*j++ = *i++;
+				continue;
 			}
 
 			// Make sure the false literal is data[1]:
@@ -965,17 +1781,36 @@ CRef Solver::notifypropagate() {
 			}
 
 			// Look for new watch:
-			for (int k = 2; k < c.size(); k++){
-				if (value(c[k]) != l_False) {
-					c[1] = c[k];
-					c[k] = false_lit;
-					watches[~c[1]].push(w);
-					/*AB*/
-					checkDecisionVars(c);
-					/*AE*/
-					goto NextClause;
+			/*AB*/
+			// (in a long clause from where the last search found one and around, like this the false
+			// literals before it are not tested again and again, see 'Clause::searchPos()')
+			int size = c.size(), k;
+			if (size < Clause::Long_Size) {
+				k = firstNonFalse(c, 2, size, assigns);
+				scanned += (k < size ? k + 1 : size) - 2;
+			} else {
+				int from = c.searchPos() < (uint32_t) size ? c.searchPos() : 2;
+				k = firstNonFalse(c, from, size, assigns);
+				scanned += (k < size ? k + 1 : size) - from;
+				if (k == size && from > 2) {
+					k = firstNonFalse(c, 2, from, assigns);
+					scanned += (k < from ? k + 1 : from) - 2;
+					if (k == from) {
+						k = size;
+					}
+				}
+				if (k < size) {
+					c.searchPos() = k;
 				}
 			}
+			if (k < size) {
+				c[1] = c[k];
+				c[k] = false_lit;
+				watches[~c[1]].push(w);
+				checkDecisionVars(c);
+				goto NextClause;
+			}
+			/*AE*/
 
 			// Did not find watch -- clause is unit under assignment:
 			*j++ = w;
@@ -1003,7 +1838,12 @@ CRef Solver::notifypropagate() {
 		/*AE*/
 	}
 	propagations += num_props;
-	simpDB_props -= num_props;
+	/*AB*/
+	ticks += visits + (visits - blocker_hits) + scanned; // (the watchers, the clauses they lead to and the literals tested)
+	stats.add(st_watch_visits, visits);
+	stats.add(st_blocker_hits, blocker_hits);
+	stats.add(st_clause_derefs, visits - blocker_hits);
+	/*AE*/
 
 	return confl;
 }
@@ -1013,8 +1853,11 @@ CRef Solver::notifypropagate() {
  |  reduceDB : ()  ->  [void]
  |
  |  Description:
- |    Remove half of the learnt clauses, minus the clauses locked by the current assignment. Locked
- |    clauses are clauses that are reason to some assignment. Binary clauses are never removed.
+ |    Reduce the learnt clause database, which is split in three tiers based on glue:
+ |      * core  -- never removed.
+ |      * mid   -- demoted to local if not used in conflict analysis since the previous call.
+ |      * local -- remove half of the clauses, minus the clauses locked by the current assignment.
+ |    Locked clauses are clauses that are reason to some assignment. Binary clauses are never removed.
  |________________________________________________________________________________________________@*/
 struct reduceDB_lt {
 	ClauseAllocator& ca;
@@ -1025,37 +1868,114 @@ struct reduceDB_lt {
 		return ca[x].size() > 2 && (ca[y].size() == 2 || ca[x].activity() < ca[y].activity());
 	}
 };
+/*AB*/
+void Solver::retier(vec<CRef>& cs, int tier) {
+	int i, j;
+	for (i = j = 0; i < cs.size(); i++) {
+		int t = ca[cs[i]].tier();
+		if (t == tier)
+			cs[j++] = cs[i];
+		else
+			learntsOf(t).push(cs[i]);
+	}
+	cs.shrink(i - j);
+}
+/*AE*/
+
 void Solver::reduceDB() {
+	/*A*/StatTimer timer(stats, st_reducedb);
 	int i, j;
-	double extra_lim = cla_inc / learnts.size(); // Remove any clause below this activity
+	/*AB*/
+	// Near the memory budget, up to 3/4 of the local tier goes instead of 1/2, and over it the mid tier is demoted whole:
+	double pressure = memoryPressure();
+	double removed = 0.5 + 0.25 * std::min(1.0, std::max(0.0, (pressure - mem_soft) / (1 - mem_soft)));
+	/*AE*/
+
+	/*AB*/
+	// Clauses promoted by 'updateGlue()' are still in the list of their old tier:
+	retier(learnts_mid, tier_mid);
+	retier(learnts_local, tier_local);
+
+	for (i = j = 0; i < learnts_mid.size(); i++) {
+		Clause& c = ca[learnts_mid[i]];
+		if (c.used() && pressure <= 1) {
+			c.used(false);
+			learnts_mid[j++] = learnts_mid[i];
+		} else {
+			c.tier(tier_local);
+			c.activity() = 0;
+			claBumpActivity(c);
+			learnts_local.push(learnts_mid[i]);
+		}
+	}
+	learnts_mid.shrink(i - j);
+	/*AE*/
+
+	double extra_lim = cla_inc / learnts_local.size(); // Remove any clause below this activity
 
-	sort(learnts, reduceDB_lt(ca));
+	sort(learnts_local, reduceDB_lt(ca));
 	// Don't delete binary or locked clauses. From the rest, delete clauses from the first half
 	// and clauses with activity smaller than 'extra_lim':
-	for (i = j = 0; i < learnts.size(); i++) {
-		Clause& c = ca[learnts[i]];
-		if (c.size() > 2 && !locked(c) && (i < learnts.size() / 2 || c.activity() < extra_lim))
-			removeClause(learnts[i]);
+	/*A*/int limit = (int) (learnts_local.size() * removed);
+	for (i = j = 0; i < learnts_local.size(); i++) {
+		Clause& c = ca[learnts_local[i]];
+		if (c.size() > 2 && !locked(c) && (i < /*A*/limit || c.activity() < extra_lim))
+			removeClause(learnts_local[i]);
 		else
-			learnts[j++] = learnts[i];
+			learnts_local[j++] = learnts_local[i];
+	}
+	learnts_local.shrink(i - j);
+	/*AB*/
+	if (pressure >= mem_soft) { // (the memory is given back now, not when the waste reaches 'garbage_frac')
+		if (learnts_local.capacity() > 2 * learnts_local.size()) learnts_local.fit();
+		if (learnts_mid.capacity() > 2 * learnts_mid.size()) learnts_mid.fit();
+	}
+	checkGarbage(pressure >= mem_soft ? garbage_frac / 4 : garbage_frac);
+	measureMemory();
+	/*AE*/
+}
+
+/*AB*/
+void Solver::checkMemory() {
+	if (memoryPressure() <= 1) return;
+	// Over the budget, the limit comes down to the learnt clauses there are, so they are reduced right away (and it
+	// only grows again below 'mem_soft'). If the problem clauses alone are over the budget, it stops at 'mem_min_learnts':
+	double lim = std::max((double) (learnts_local.size() - nAssigns()), mem_min_learnts);
+	if (lim < max_learnts) {
+		max_learnts = lim;
+		memory_reductions++;
 	}
-	learnts.shrink(i - j);
-	checkGarbage();
 }
 
+void Solver::measureMemory() {
+	arena_bytes = (uint64_t) ca.size() * ClauseAllocator::Unit_Size;
+	watch_bytes = watches.bytes() + binwatches.bytes();
+}
+/*AE*/
+
 void Solver::removeSatisfied(vec<CRef>& cs) {
 	int i, j;
+	/*A*/int exported = 0; // Removed clauses in the exported prefix.
 	for (i = j = 0; i < cs.size(); i++) {
 		Clause& c = ca[cs[i]];
-		if (satisfied(c))
+		if (satisfied(c)) {
 			removeClause(cs[i]);
-		else
+			/*A*/exported += i < export_clauses;
+		} else
 			cs[j++] = cs[i];
 	}
 	cs.shrink(i - j);
+	/*A*/if (&cs == &clauses) export_clauses -= exported;
 }
 
 void Solver::rebuildOrderHeap() {
+	/*AB*/
+	flushDecidable(); // (pending variables were never inserted, so their heap index does not exist yet)
+	if (heuristic == heur_vmtf) { // (the variables were never inserted in 'order_heap')
+		vmtf.reset();
+		return;
+	}
+	/*AE*/
 	vec<Var> vs;
 	for (Var v = 0; v < nVars(); v++)
 		if (decision[v] && value(v) == l_Undef)
@@ -1072,27 +1992,460 @@ void Solver::rebuildOrderHeap() {
  |    thing done here is the removal of satisfied clauses, but more things can be put here.
  |________________________________________________________________________________________________@*/
 bool Solver::simplify() {
+	/*A*/StatTimer timer(stats, st_simplify);
 	assert(decisionLevel() == 0);
 
 	if (!ok || propagate() != CRef_Undef)
 		return ok = false;
 
-	if (nAssigns() == simpDB_assigns || (simpDB_props > 0))
+	if (nAssigns() == simpDB_assigns || /*A*/ticks < simpDB_ticks)
 		return true;
 
 	// Remove satisfied clauses:
-	removeSatisfied(learnts);
+	/*AB*/
+	removeSatisfied(learnts_core);
+	removeSatisfied(learnts_mid);
+	removeSatisfied(learnts_local);
+	/*AE*/
 	if (remove_satisfied) // Can be turned off.
 		removeSatisfied(clauses);
 	checkGarbage();
 	rebuildOrderHeap();
 
 	simpDB_assigns = nAssigns();
-	simpDB_props = clauses_literals + learnts_literals; // (shouldn't depend on stats really, but it will do for now)
+	/*A*/simpDB_ticks = ticks + clauses_literals + learnts_literals; // (the cost of these scans in ticks, so that search gets at least as many)
 
 	return true;
 }
 
+/*AB*/
+/*_________________________________________________________________________________________________
+ |
+ |  inprocess : [void]  ->  [bool]
+ |
+ |  Description:
+ |    Simplify the clause database at the root level during search:
+ |      * the problem clauses added since the last round subsume or strengthen (by self-subsuming
+ |        resolution) other clauses. Occurrence lists are only built for their variables.
+ |      * learnt clauses of the core and mid tiers are vivified, continuing where the last round stopped.
+ |    The effort is limited to 'inprocess_frac' times the propagations of search since the last round.
+ |    No variables are eliminated, as the other propagators can refer to any of them.
+ |    Returns false if the problem was found unsatisfiable.
+ |________________________________________________________________________________________________@*/
+bool Solver::inprocess() {
+	/*A*/StatTimer timer(stats, st_inprocess);
+	assert(decisionLevel() == 0);
+	inprocessings++;
+	next_inprocess = conflicts + (uint64_t) inprocess_int * (inprocessings + 1);
+
+	// NOTE: clauses that can be rolled back must not subsume or strengthen the others.
+	if (checkpoints.size() > 0) {
+		inprocess_queue.clear();
+		return true;
+	}
+
+	int64_t budget = (int64_t) (inprocess_frac * (propagations - inprocess_props));
+	int64_t work = 0;
+	if (ok) {
+		subsumeQueued(work, budget);
+	}
+	ticks += work; // (of the occurrence lists; vivification propagates, which counts itself)
+	if (ok) {
+		vivifyLearnts(work, budget);
+	}
+
+	purgeRemoved(clauses);
+	purgeRemoved(learnts_core);
+	purgeRemoved(learnts_mid);
+	purgeRemoved(learnts_local);
+	checkGarbage();
+	inprocess_props = propagations;
+	return ok;
+}
+
+void Solver::purgeRemoved(vec<CRef>& cs) {
+	int i, j, exported = 0; // (removed clauses in the exported prefix of 'clauses')
+	for (i = j = 0; i < cs.size(); i++)
+		if (ca[cs[i]].mark() == 0)
+			cs[j++] = cs[i];
+		else
+			exported += i < export_clauses;
+	cs.shrink(i - j);
+	if (&cs == &clauses) export_clauses -= exported;
+}
+
+// 64 bit signatures of sets of variables: a clause can only subsume (or strengthen) another one if its signature is a
+// subset of the other's. The variables are hashed, so that large instances do not fold onto the same few bits.
+static inline uint64_t varSignature(Var v) {
+	return (uint64_t) 1 << (((uint64_t) v * 0x9E3779B97F4A7C15ULL) >> 58);
+}
+
+static inline uint64_t clauseSignature(const Clause& c) {
+	uint64_t sig = 0;
+	for (int i = 0; i < c.size(); i++)
+		sig |= varSignature(var(c[i]));
+	return sig;
+}
+
+namespace {
+struct Subsumer {
+	Var best; // The variable of the clause with the fewest occurrences.
+	int size;
+	CRef cr;
+};
+struct Subsumer_lt {
+	bool operator ()(const Subsumer& x, const Subsumer& y) const {
+		return x.best < y.best || (x.best == y.best && x.size < y.size);
+	}
+};
+}
+
+// Backward subsumption and self-subsuming resolution with the clauses of 'inprocess_queue' against all clauses.
+// The queued clauses are grouped by their variable with the fewest occurrences, so each of these occurrence lists is
+// walked once for the whole group: every occurring clause is marked once, filtered by signature against all clauses of
+// the group and then checked against the remaining ones (smallest first).
+void Solver::subsumeQueued(int64_t& work, int64_t budget) {
+	inproc_occ.growTo(nVars());
+	inproc_sigs.growTo(nVars());
+	inproc_touched.growTo(nVars(), 0);
+	vec<Var> touched;
+	for (int i = 0; i < inprocess_queue.size(); i++) {
+		const Clause& c = ca[inprocess_queue[i]];
+		if (c.mark() != 0)
+			continue;
+		for (int k = 0; k < c.size(); k++)
+			if (!inproc_touched[var(c[k])]) {
+				inproc_touched[var(c[k])] = 1;
+				touched.push(var(c[k]));
+			}
+	}
+
+	// Occurrences (and signatures) of the touched variables:
+	vec<CRef>* lists[] = { &clauses, &learnts_core, &learnts_mid, &learnts_local };
+	for (int l = 0; l < 4; l++)
+		for (int i = 0; i < lists[l]->size(); i++) {
+			CRef cr = (*lists[l])[i];
+			const Clause& c = ca[cr];
+			if (c.mark() != 0)
+				continue;
+			work += c.size();
+			uint64_t sig = clauseSignature(c);
+			for (int k = 0; k < c.size(); k++)
+				if (inproc_touched[var(c[k])]) {
+					inproc_occ[var(c[k])].push(cr);
+					inproc_sigs[var(c[k])].push(sig);
+				}
+		}
+
+	vec<Subsumer> subs;
+	for (int i = 0; i < inprocess_queue.size(); i++) {
+		const Clause& c = ca[inprocess_queue[i]];
+		if (c.mark() != 0)
+			continue;
+		Subsumer sub = { var(c[0]), c.size(), inprocess_queue[i] };
+		for (int k = 1; k < c.size(); k++)
+			if (inproc_occ[var(c[k])].size() < inproc_occ[sub.best].size())
+				sub.best = var(c[k]);
+		subs.push(sub);
+	}
+	sort(subs, Subsumer_lt());
+	vec<uint64_t> sub_sigs(subs.size()); // (contiguous, for the signature filter)
+	for (int i = 0; i < subs.size(); i++)
+		sub_sigs[i] = clauseSignature(ca[subs[i].cr]);
+
+	auto mark = [&](CRef cr, char m) {
+		const Clause& d = ca[cr];
+		for (int k = 0; k < d.size(); k++)
+			seen[var(d[k])] = m == 0 ? 0 : 1 + sign(d[k]);
+	};
+
+	vec<CRef> strengthened;
+	int g = 0;
+	for (int end; g < subs.size() && ok && work < budget; g = end) {
+		Var v = subs[g].best;
+		for (end = g + 1; end < subs.size() && subs[end].best == v; end++)
+			;
+		const vec<CRef>& os = inproc_occ[v];
+		const vec<uint64_t>& sigs = inproc_sigs[v];
+		for (int j = 0; j < os.size() && ok; j++) {
+			CRef dr = os[j];
+			uint64_t sd = sigs[j];
+			bool marked = false;
+			work += end - g;
+			for (int i = g; i < end; i++) {
+				if ((sub_sigs[i] & ~sd) != 0 || subs[i].cr == dr)
+					continue;
+				const Clause& c = ca[subs[i].cr];
+				const Clause& d = ca[dr];
+				if (d.mark() != 0)
+					break;
+				if (c.mark() != 0 || c.size() > d.size())
+					continue;
+				if (!marked) {
+					work += d.size();
+					mark(dr, 1);
+					marked = true;
+				}
+
+				// Every literal of 'c' must be in 'd', at most one of them negated:
+				work += c.size();
+				Lit opposite = lit_Undef;
+				int k;
+				for (k = 0; k < c.size(); k++) {
+					char m = seen[var(c[k])];
+					if (m == 1 + sign(c[k]))
+						continue;
+					if (m == 0 || opposite != lit_Undef)
+						break;
+					opposite = ~c[k];
+				}
+				if (k < c.size())
+					continue;
+
+				mark(dr, 0);
+				marked = false;
+				if (opposite == lit_Undef) {
+					removeClause(dr);
+					inproc_subsumed++;
+				} else {
+					inproc_strengthened++;
+					if (!strengthenRoot(dr, opposite))
+						ok = false;
+					else if (ca[dr].mark() == 0 && !ca[dr].learnt())
+						strengthened.push(dr); // (it may subsume more now)
+				}
+				break;
+			}
+			if (marked)
+				mark(dr, 0);
+		}
+	}
+
+	for (int i = 0; i < touched.size(); i++) {
+		inproc_occ[touched[i]].clear();
+		inproc_sigs[touched[i]].clear();
+		inproc_touched[touched[i]] = 0;
+	}
+
+	// The groups that the budget did not reach and the strengthened clauses are for the next round:
+	inprocess_queue.clear();
+	for (int i = g; i < subs.size(); i++)
+		if (ca[subs[i].cr].mark() == 0)
+			inprocess_queue.push(subs[i].cr);
+	for (int i = 0; i < strengthened.size(); i++)
+		if (ca[strengthened[i]].mark() == 0)
+			inprocess_queue.push(strengthened[i]);
+	sort(inprocess_queue);
+	int j = 0;
+	for (int i = 0; i < inprocess_queue.size(); i++)
+		if (j == 0 || inprocess_queue[i] != inprocess_queue[j - 1])
+			inprocess_queue[j++] = inprocess_queue[i];
+	inprocess_queue.shrink(inprocess_queue.size() - j);
+}
+
+namespace {
+struct XorCandidate {
+	uint64_t sig;
+	int size;
+	CRef cr;
+};
+struct XorCandidate_lt {
+	bool operator ()(const XorCandidate& x, const XorCandidate& y) const {
+		return x.size < y.size || (x.size == y.size && x.sig < y.sig);
+	}
+};
+}
+
+// Clauses with the same variables are found by sorting on size and signature. For 'k' variables, the negations of a clause
+// form a pattern of 'k' bits that excludes the assignment with that pattern: if all 2^(k-1) patterns of the same parity are
+// present, the clauses are the XOR with the other parity.
+void Solver::findXors(std::vector<Xor>& xors, int max_size) const {
+	assert(max_size <= 6); // (the patterns of one variable set fit in 64 bits)
+	vec<XorCandidate> cands;
+	for (int i = 0; i < clauses.size(); i++) {
+		const Clause& c = ca[clauses[i]];
+		if (c.mark() == 0 && c.size() >= 3 && c.size() <= max_size) {
+			XorCandidate cand = { clauseSignature(c), c.size(), clauses[i] };
+			cands.push(cand);
+		}
+	}
+	sort(cands, XorCandidate_lt());
+
+	vec<Var> vars, other;
+	vec<char> done;
+	for (int g = 0, end; g < cands.size(); g = end) {
+		for (end = g + 1; end < cands.size() && cands[end].size == cands[g].size && cands[end].sig == cands[g].sig; end++)
+			;
+		int k = cands[g].size;
+		if (end - g < (1 << (k - 1))) {
+			continue;
+		}
+		// Within a group, several sets of variables can share a signature:
+		done.clear();
+		done.growTo(end - g, 0);
+		for (int first = g; first < end; first++) {
+			if (done[first - g]) {
+				continue;
+			}
+			const Clause& c = ca[cands[first].cr];
+			vars.clear();
+			for (int i = 0; i < k; i++)
+				vars.push(var(c[i]));
+			sort(vars);
+
+			uint64_t patterns = 0;
+			for (int j = first; j < end; j++) {
+				const Clause& d = ca[cands[j].cr];
+				other.clear();
+				for (int i = 0; i < k; i++)
+					other.push(var(d[i]));
+				sort(other);
+				int i;
+				for (i = 0; i < k && vars[i] == other[i]; i++)
+					;
+				if (i < k) {
+					continue;
+				}
+				done[j - g] = 1;
+				int pattern = 0;
+				for (int l = 0; l < k; l++)
+					if (sign(d[l]))
+						pattern |= 1 << (std::lower_bound((const Var*) vars, (const Var*) vars + k, var(d[l])) - (const Var*) vars);
+				patterns |= (uint64_t) 1 << pattern;
+			}
+
+			uint64_t even = 0; // (the patterns with an even number of negations)
+			for (int p = 0; p < (1 << k); p++)
+				if (__builtin_popcount(p) % 2 == 0)
+					even |= (uint64_t) 1 << p;
+			uint64_t all = k == 6 ? ~(uint64_t) 0 : ((uint64_t) 1 << (1 << k)) - 1;
+			bool excludes_even = (patterns & even) == even, excludes_odd = (patterns & (all & ~even)) == (all & ~even);
+			if (excludes_even == excludes_odd) {
+				continue; // (both: the clauses are unsatisfiable, which propagation finds anyway)
+			}
+			Xor x;
+			for (int i = 0; i < k; i++)
+				x.vars.push_back(vars[i]);
+			// A clause with an even pattern excludes an assignment with an even number of true variables:
+			x.rhs = excludes_even;
+			xors.push_back(x);
+		}
+	}
+}
+
+// Remove 'p' from the clause 'cr' at the root level, propagating if the clause becomes unit. Returns false on a conflict.
+bool Solver::strengthenRoot(CRef cr, Lit p) {
+	assert(decisionLevel() == 0);
+	Clause& c = ca[cr];
+	if (satisfied(c)) {
+		removeClause(cr);
+		return true;
+	}
+	detachClause(cr, true);
+	c.strengthen(p);
+	if (proof.isOpen()) {
+		proof.add(c);
+		proof.remove(c, p);
+	}
+	int nonfalse = 0;
+	for (int i = 0; i < c.size(); i++)
+		if (value(c[i]) == l_Undef)
+			swap(c, i, nonfalse++);
+	if (nonfalse >= 2) {
+		attachClause(cr);
+		return true;
+	}
+	Lit unit = c[0];
+	c.mark(1);
+	ca.free(cr); // (stays in the proof, as the reason of 'unit')
+	if (nonfalse == 0)
+		return false;
+	uncheckedEnqueue(unit);
+	return propagate() == CRef_Undef;
+}
+
+// Vivify the learnt clauses of the core and mid tiers, round-robin over the rounds.
+void Solver::vivifyLearnts(int64_t& work, int64_t budget) {
+	int n = learnts_core.size() + learnts_mid.size();
+	for (int tried = 0; tried < n && ok && work < budget; tried++) {
+		if (vivify_next >= n)
+			vivify_next = 0;
+		CRef cr = vivify_next < learnts_core.size() ? learnts_core[vivify_next] : learnts_mid[vivify_next - learnts_core.size()];
+		vivify_next++;
+		if (ca[cr].mark() != 0)
+			continue;
+		uint64_t props = propagations;
+		if (!vivify(cr))
+			ok = false;
+		work += ca[cr].size() + (propagations - props);
+	}
+}
+
+// Shorten the learnt clause 'cr' by assigning the negation of its literals one by one: literals that become false can
+// be removed, and the rest can be dropped as soon as one becomes true or propagation fails. Returns false on a conflict
+// at the root level.
+bool Solver::vivify(CRef cr) {
+	assert(decisionLevel() == 0);
+	if (satisfied(ca[cr]) || locked(ca[cr]))
+		return true;
+
+	// NOTE: a copy, propagation moves the watches of the clause itself (and can add clauses, so 'ca[cr]' is not kept as a reference)
+	int size = ca[cr].size();
+	vivify_lits.clear();
+	for (int i = 0; i < size; i++)
+		vivify_lits.push(ca[cr][i]);
+	int kept = 0;
+	for (int i = 0; i < size; i++) {
+		Lit l = vivify_lits[i];
+		if (value(l) == l_False)
+			continue;
+		vivify_lits[kept++] = l;
+		if (value(l) == l_True)
+			break;
+		createNewDecisionLevel();
+		uncheckedEnqueue(~l);
+		if (propagate() != CRef_Undef)
+			break;
+	}
+	vivify_lits.shrink(size - kept);
+	int saving = phase_saving;
+	phase_saving = 0; // (the probe assigned the negations of the literals, they are not phases to keep)
+	cancelUntil(0);
+	phase_saving = saving;
+	if (!ok)
+		return false;
+	if (vivify_lits.size() == size)
+		return true;
+
+	inproc_vivified += size - vivify_lits.size();
+	Clause& c = ca[cr];
+	detachClause(cr, true);
+	if (proof.isOpen()) {
+		proof.add(vivify_lits);
+		proof.remove(c);
+	}
+	for (int i = 0; i < vivify_lits.size(); i++)
+		c[i] = vivify_lits[i];
+	c.shrink(size - vivify_lits.size());
+	if (satisfied(c) || c.size() < 2) {
+		Lit unit = c[0];
+		bool sat = satisfied(c);
+		if (sat && proof.isOpen())
+			proof.remove(c);
+		c.mark(1);
+		ca.free(cr);
+		if (sat || value(unit) == l_True)
+			return true;
+		uncheckedEnqueue(unit);
+		return propagate() == CRef_Undef;
+	}
+	if ((int) c.glue() > c.size() - 1)
+		c.glue(c.size() - 1);
+	attachClause(cr);
+	return true;
+}
+/*AE*/
+
 /*_________________________________________________________________________________________________
  |
  |  search : (nof_conflicts : int) (params : const SearchParams&)  ->  [lbool]
@@ -1109,6 +2462,7 @@ bool Solver::simplify() {
 lbool Solver::search(int nof_conflicts/*AB*/, bool nosearch/*AE*/) {
 	assert(ok);
 	int backtrack_level;
+	/*A*/int glue;
 	int conflictC = 0;
 	vec<Lit> learnt_clause;
 	starts++;
@@ -1139,23 +2493,53 @@ lbool Solver::search(int nof_conflicts/*AB*/, bool nosearch/*AE*/) {
 			if (decisionLevel() == 0){
 				return l_False;
 			}
+			/*AB*/
+			int confl_level = conflictLevel(confl);
+			if (confl_level == 0) { // (root literals can be above the root, see 'injectClause()')
+				cancelUntil(0);
+				return l_False;
+			}
+			if (packed && confl_level <= 1) { // NOTE: 'analyze()' needs a single decision per level, so find this conflict again with one level per assumption
+				packed = false;
+				cancelUntil(0);
+				continue;
+			}
+			if (targetPhases() || rephasing()) {
+				saveTrailPhases(confl_level);
+			}
+			/*AE*/
 
 			learnt_clause.clear();
+			/*AB*/
+			if (stats_interval > 0 && conflicts % stats_interval == 0) {
+				recordProgress();
+			}
+			if (StatsRegistry::dumpRequested()) {
+				writeStats();
+			}
+			/*AE*/
+
+			/*A*/int trailsize = trail.size();
+			analyze(confl, learnt_clause, backtrack_level, glue);
 
-			analyze(confl, learnt_clause, backtrack_level);
+			/*AB*/
+			if (glueRestarts()) {
+				// Block the restart while the solver seems to approach a model (an unusually large assignment):
+				if (block_margin > 0 && conflicts > (uint64_t) block_after && conflictC >= restart_min && trailsize > block_margin * ema_trail) {
+					blocked_restarts++;
+					conflictC = 0;
+				}
+				updateRestartAverages(glue);
+				ema_trail += (trailsize - ema_trail) / (ema_count < 5000 ? ema_count : 5000);
+			}
+			/*AE*/
 
-			cancelUntil(backtrack_level);
+			/*A*/cancelUntil(conflictBacktrackLevel(backtrack_level, learnt_clause.size()));
+			/*A*/strengthenAntecedents();
 
 			//FIXME inconsistency with addLearnedClause method
-			if (learnt_clause.size() == 1) {
-				uncheckedEnqueue(learnt_clause[0]);
-			} else {
-				CRef cr = ca.alloc(learnt_clause, true);
-				addToClauses(cr, true);
-				attachClause(cr);
-				claBumpActivity(ca[cr]);
-				uncheckedEnqueue(learnt_clause[0], cr);
-			}
+			recordLearnt(learnt_clause, glue);
+			/*A*/if (mem_budget > 0) checkMemory();
 
 			varDecayActivity();
 			claDecayActivity();
@@ -1163,9 +2547,10 @@ lbool Solver::search(int nof_conflicts/*AB*/, bool nosearch/*AE*/) {
 			if (--learntsize_adjust_cnt == 0) {
 				learntsize_adjust_confl *= learntsize_adjust_inc;
 				learntsize_adjust_cnt = (int) learntsize_adjust_confl;
+				/*A*/if (memoryPressure() < mem_soft) // (near the budget, the limit only comes down, see 'checkMemory()')
 				max_learnts *= learntsize_inc;
 
-				if (verbosity >= 1)
+				if (verbosity >= 1 /*A*/&& stats_interval == 0)
 					fprintf(stderr,"| %9d | %7d %8d %8d | %8d %8d %6.0f | %6.3f %% |\n", (int) conflicts,
 							(int) dec_vars - (trail_lim.size() == 0 ? trail.size() : trail_lim[0]), nClauses(), (int) clauses_literals, (int) max_learnts,
 							nLearnts(), (double) learnts_literals / nLearnts(), progressEstimate() * 100);
@@ -1173,10 +2558,11 @@ lbool Solver::search(int nof_conflicts/*AB*/, bool nosearch/*AE*/) {
 
 		} else {
 			// NO CONFLICT
-			if ((nof_conflicts >= 0 && conflictC >= nof_conflicts) || !withinBudget()) {
+			/*A*/bool restart = glueRestarts() ? glueRestartDue(conflictC) : (nof_conflicts >= 0 && conflictC >= nof_conflicts);
+			if (restart || !withinBudget()) {
 				// Reached bound on number of conflicts:
 				progress_estimate = progressEstimate();
-				cancelUntil(0);
+				/*A*/cancelUntil(withinBudget() ? restartLevel() : 0);
 				return l_Undef;
 			}
 
@@ -1184,14 +2570,24 @@ lbool Solver::search(int nof_conflicts/*AB*/, bool nosearch/*AE*/) {
 			if (decisionLevel() == 0 && !simplify()){
 				return l_False;
 			}
+			/*A*/if (decisionLevel() == 0 && use_inprocess && conflicts >= next_inprocess && !inprocess()) return l_False;
 
-			if (learnts.size() - nAssigns() >= max_learnts){
+			if (learnts_local.size() - nAssigns() >= max_learnts){
 				// Reduce the set of learnt clauses:
 				reduceDB();
 			}
 
 			Lit next = lit_Undef;
-			while (decisionLevel() < assumptions.size()) {
+			/*AB*/
+			if (packed && decisionLevel() == 0) {
+				createNewDecisionLevel();
+				if (!decidePackedAssumptions()) {
+					return l_False;
+				}
+				continue; // (propagate them first)
+			}
+			/*AE*/
+			while (/*A*/!packed && decisionLevel() < assumptions.size()) {
 				// Perform user provided assumption:
 				Lit p = assumptions[decisionLevel()];
 				if (value(p) == l_True) {
@@ -1220,8 +2616,13 @@ lbool Solver::search(int nof_conflicts/*AB*/, bool nosearch/*AE*/) {
 				if (next == lit_Undef) {
 					fullassignment = true;
 
-					confl = getPCSolver().checkFullAssignment(); // NOTE: can backtrack as any propagator, so in that case should not stop
-					if (order_heap.size()>0 || qhead!=trail.size()) {
+					/*AB*/
+					{
+						StatTimer callback(stats, st_callbacks);
+						confl = getPCSolver().checkFullAssignment(); // NOTE: can backtrack as any propagator, so in that case should not stop
+					}
+					/*AE*/
+					if (/*A*/hasCandidates() || qhead!=trail.size()) {
 						continue;
 					}
 
@@ -1258,30 +2659,293 @@ lbool Solver::search(int nof_conflicts/*AB*/, bool nosearch/*AE*/) {
 bool Solver::handleConflict(CRef conflict){
 	CRef confl = conflict;
 	while(confl!=CRef_Undef){
-		if(decisionLevel()==0){
+		if(decisionLevel()==0 /*A*/|| conflictLevel(confl) == 0){
+			/*A*/cancelUntil(0);
 			return true;
 		}
-		int backtrack_level;
+		int backtrack_level, glue;
 		vec<Lit> learnt_clause;
-		analyze(confl, learnt_clause, backtrack_level);
+		analyze(confl, learnt_clause, backtrack_level, glue);
 
-		cancelUntil(backtrack_level);
+		cancelUntil(conflictBacktrackLevel(backtrack_level, learnt_clause.size()));
+		strengthenAntecedents();
 
-		if (learnt_clause.size() == 1) {
-			uncheckedEnqueue(learnt_clause[0]);
-		} else {
-			CRef cr = ca.alloc(learnt_clause, true);
-			addToClauses(cr, true);
-			attachClause(cr);
-			claBumpActivity(ca[cr]);
-			uncheckedEnqueue(learnt_clause[0], cr);
-		}
+		recordLearnt(learnt_clause, glue);
 
 		confl = propagate();
 	}
 
 	return false;
 }
+
+void Solver::recordLearnt(vec<Lit>& learnt_clause, int glue) {
+	if (exchange != NULL) {
+		exportLearnt(learnt_clause, glue);
+	}
+	stats.sample(st_glue, glue);
+	if (proof.isOpen()) {
+		proof.add(learnt_clause);
+	}
+	if (learnt_clause.size() == 1) {
+		uncheckedEnqueue(learnt_clause[0]);
+		root_epoch[var(learnt_clause[0])] = analyze_epoch;
+	} else {
+		CRef cr = ca.alloc(learnt_clause, true);
+		ca[cr].glue(glue);
+		ca[cr].epoch(analyze_epoch);
+		addToClauses(cr, true);
+		attachClause(cr);
+		claBumpActivity(ca[cr]);
+		// NOTE: after chronological backtracking, the asserting literal is implied at a lower level than the current one
+		uncheckedEnqueue(learnt_clause[0], cr, learnt_clause.size() == 2 ? learnt_clause[1] : lit_Undef, level(var(learnt_clause[1])));
+	}
+}
+
+// Backtracking only one level keeps the assignments (and the state of the theory propagators) of the levels in between.
+// If the conflict clause has only one literal at the highest level, analysis learns it again as a lower level reason.
+// NOTE: also inserts the variables made decidable by 'checkFullAssignment()'.
+bool Solver::hasCandidates() {
+	flushDecidable();
+	return heuristic == heur_vmtf ? not vmtf.empty() : order_heap.size() > 0;
+}
+
+int Solver::conflictBacktrackLevel(int backtrack_level, int learnt_size) {
+	if (chrono < 0 || learnt_size == 1 || conflicts <= (uint64_t) chrono_after || decisionLevel() - backtrack_level <= chrono) {
+		return backtrack_level;
+	}
+	chrono_backtracks++;
+	return decisionLevel() - 1;
+}
+
+void Solver::exportLearnt(const vec<Lit>& learnt_clause, int glue) {
+	// NOTE: clauses that depend on a checkpoint could be rolled back, and the other solvers would keep them.
+	if (checkpoints.size() > 0 || learnt_clause.size() > ClauseExchange::Max_Size || (learnt_clause.size() > 2 && glue > share_lbd)) {
+		return;
+	}
+	exchange->exportClause(exchange_id, &learnt_clause[0], learnt_clause.size(), glue);
+	shared_exported++;
+}
+
+// NOTE: only sound if all solvers of the portfolio were given the same theory (with the same variable numbering).
+void Solver::importShared() {
+	assert(decisionLevel() == 0);
+	auto add = [this](const Lit* lits, int size, int glue) {
+		if (not ok) {
+			return;
+		}
+		import_tmp.clear();
+		for (int i = 0; i < size; i++) {
+			if (var(lits[i]) >= nVars()) { // Not (yet) known by this solver
+				return;
+			}
+			import_tmp.push(lits[i]);
+		}
+		shared_imported++;
+		if (size == 1 && value(lits[0]) == l_Undef) {
+			shared_useful++;
+		}
+		addClause_(import_tmp, true, glue);
+	};
+	exchange->importClauses(exchange_id, add);
+}
+/*AE*/
+
+/*AB*/
+// Moving averages with a smoothing factor of 1/32 (fast) and 1/4096 (slow). While there are fewer samples, the
+// plain average is used instead, which removes the bias towards the initial value 0.
+void Solver::updateRestartAverages(int glue) {
+	ema_count++;
+	ema_glue_fast += (glue - ema_glue_fast) / (ema_count < 32 ? ema_count : 32);
+	ema_glue_slow += (glue - ema_glue_slow) / (ema_count < 4096 ? ema_count : 4096);
+}
+
+bool Solver::glueRestartDue(int conflictC) const {
+	return conflictC >= restart_min && ema_glue_fast > restart_margin * ema_glue_slow;
+}
+
+// The decisions that are more active than the variable that would be chosen next would be made again right after
+// a full restart, so they (and the propagation of the theory propagators) can be kept.
+int Solver::restartLevel() {
+	if (not partial_restart || decisionLevel() == 0) {
+		return 0;
+	}
+	flushDecidable();
+	Var next = var_Undef;
+	if (heuristic == heur_vmtf) {
+		next = vmtf.next(assigns, decision);
+	} else {
+		while (not order_heap.empty()) {
+			Var v = order_heap[0];
+			if (value(v) == l_Undef && decision[v]) {
+				next = v;
+				break;
+			}
+			order_heap.removeMin(); // NOTE: assigned variables are inserted again when unassigned
+		}
+	}
+	if (next == var_Undef) {
+		return 0;
+	}
+	int level = std::min(assumptionLevels(), decisionLevel()); // Assumptions would be decided again anyway
+	for (; level < decisionLevel(); level++) {
+		int end = level + 1 < decisionLevel() ? trail_lim[level + 1] : trail.size();
+		if (trail_lim[level] < end && varScore(var(trail[trail_lim[level]])) <= varScore(next)) {
+			break;
+		}
+	}
+	reused_levels += level;
+	return level;
+}
+
+// The decision levels of the trail that 'search()' would make again for 'assumptions': level 'i + 1' has decided
+// 'assumptions[i]', or is empty while 'assumptions[i]' was already true. Level 1 of packed assumptions is kept if all its
+// decisions are assumptions.
+int Solver::keptAssumptionLevels() {
+	int n = std::min(decisionLevel(), assumptionLevels());
+	if (packed && n > 0) {
+		for (int i = 0; i < assumptions.size(); i++) {
+			seen[var(assumptions[i])] = 1 + sign(assumptions[i]);
+		}
+		int i, end = decisionLevel() > 1 ? trail_lim[1] : trail.size();
+		for (i = trail_lim[0]; i < end; i++) {
+			Lit q = trail[i];
+			if (level(var(q)) == 1 && reason(var(q)) == CRef_Undef && seen[var(q)] != 1 + sign(q)) {
+				break;
+			}
+		}
+		for (int k = 0; k < assumptions.size(); k++) {
+			seen[var(assumptions[k])] = 0;
+		}
+		return i == end ? 1 : 0;
+	}
+	int kept = 0;
+	for (; kept < n; kept++) {
+		int beg = trail_lim[kept], end = kept + 1 < decisionLevel() ? trail_lim[kept + 1] : trail.size();
+		Lit p = assumptions[kept];
+		bool decided = beg < end && level(var(trail[beg])) == kept + 1; // (otherwise a dummy level, possibly with literals kept by chronological backtracking)
+		if (decided ? trail[beg] != p : value(p) != l_True || level(var(p)) > kept) {
+			break;
+		}
+	}
+	return kept;
+}
+
+// Backtrack to the levels of 'keptAssumptionLevels()' instead of the root, and restore the invariant of the watches of the
+// clauses added above the root since the last call: a clause that is false under the kept levels backtracks below its last
+// literal (like 'addClause_()'), one that is unit is propagated at the level where it became unit, and one whose only
+// true literal was assigned after the others became false backtracks to where it became unit. Only the clauses that
+// were added meanwhile are visited.
+bool Solver::reuseTrail() {
+	bool pack = pack_assumps && assumptions.size() > 0;
+	if (!reuse_assumps) { // (the caller backtracks)
+		added_above_root.clear();
+		packed = pack;
+		return true;
+	}
+	int kept = packed == pack ? keptAssumptionLevels() : 0;
+	packed = pack;
+	for (int i = 0; i < added_above_root.size() && kept > 0; i++) {
+		const Clause& c = ca[added_above_root[i]];
+		auto falseKept = [&](Lit q) { return value(q) == l_False && level(var(q)) <= kept; };
+		if (c.mark() != 0 || (!falseKept(c[0]) && !falseKept(c[1]))) {
+			continue;
+		}
+		int nonfalse = 0, top = 0;
+		Lit t = lit_Undef;
+		for (int k = 0; k < c.size(); k++) {
+			if (falseKept(c[k])) {
+				top = std::max(top, level(var(c[k])));
+			} else {
+				nonfalse++;
+				t = c[k];
+			}
+		}
+		if (nonfalse == 0) {
+			kept = std::max(top - 1, 0); // (a conflict at the root is found below)
+		} else if (nonfalse == 1 && value(t) == l_True && level(var(t)) > top) {
+			kept = top;
+		}
+	}
+	reused_assumption_levels += kept;
+	cancelUntil(kept);
+
+	for (int i = 0; i < added_above_root.size(); i++) {
+		CRef cr = added_above_root[i];
+		Clause& c = ca[cr];
+		if (c.mark() != 0 || (value(c[0]) != l_False && value(c[1]) != l_False)) {
+			continue;
+		}
+		// Watch the non-false literals, or else the false literals of the highest levels:
+		detachClause(cr, true);
+		for (int w = 0; w < 2; w++) {
+			int best = w;
+			for (int k = w + 1; k < c.size(); k++) {
+				if (value(c[best]) == l_False && (value(c[k]) != l_False || level(var(c[k])) > level(var(c[best])))) {
+					best = k;
+				}
+			}
+			swap(c, w, best);
+		}
+		attachClause(cr); // (which propagates an input clause that is unit above the root itself)
+		repaired_clauses++;
+		if (value(c[0]) == l_False) { // (only at the root, see above)
+			added_above_root.clear();
+			return ok = false;
+		}
+		if (value(c[0]) == l_Undef && value(c[1]) == l_False) {
+			enqueueUnit(cr);
+		}
+	}
+	added_above_root.clear();
+	return true;
+}
+
+bool Solver::decidePackedAssumptions() {
+	for (int i = 0; i < assumptions.size(); i++) {
+		Lit p = assumptions[i];
+		if (value(p) == l_False) {
+			analyzeFinal(~p, conflict);
+			return false;
+		}
+		if (value(p) == l_Undef) {
+			uncheckedEnqueue(p);
+		}
+	}
+	return true;
+}
+
+void Solver::enqueueUnit(CRef cr) {
+	const Clause& c = ca[cr];
+	uncheckedEnqueue(c[0], cr, c.size() == 2 ? c[1] : lit_Undef, level(var(c[1]))); // (so backtracking to a level in between keeps it)
+}
+
+int Solver::conflictLevel(CRef confl) const {
+	const Clause& c = ca[confl];
+	int lvl = 0;
+	for (int i = 0; i < c.size(); i++) {
+		lvl = std::max(lvl, level(var(c[i])));
+	}
+	return lvl;
+}
+/*AE*/
+
+/*AB*/
+static int64_t steadyNanoseconds() {
+	return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+void Solver::setDeadline(double seconds) {
+	deadline = steadyNanoseconds() + (int64_t) (seconds * 1e9);
+	deadline_poll = ticks;
+}
+
+bool Solver::beforeDeadline() const {
+	if (steadyNanoseconds() >= deadline) {
+		return false; // (and the clock is read again on the next call)
+	}
+	deadline_poll = ticks + deadline_poll_ticks;
+	return true;
+}
 /*AE*/
 
 double Solver::progressEstimate() const {
@@ -1325,8 +2989,30 @@ static double luby(double y, int x) {
 	return pow(y, seq);
 }
 
+/*AB*/
+namespace {
+struct FlagScope { // Sets 'flag' for the lifetime of the scope.
+	bool& flag;
+	FlagScope(bool& flag) : flag(flag) { flag = true; }
+	~FlagScope() { flag = false; }
+};
+
+struct StatsScope { // Writes the statistics of 's' to its 'stats_file' (if any) at the end of the scope.
+	Solver& s;
+	StatsScope(Solver& s) : s(s) {}
+	~StatsScope() { if (s.stats_file != NULL) s.writeStats(); }
+};
+}
+/*AE*/
+
 // NOTE: assumptions passed in member-variable 'assumptions'.
 lbool Solver::solve_(/*AB*/bool nosearch/*AE*/) {
+	/*AB*/
+	if (drat_file != NULL) {
+		openDratFile();
+	}
+	StatsScope write_stats(*this); // NOTE: the solvers of a portfolio or cube-and-conquer have none
+	/*AE*/
 	model.clear();
 	conflict.clear();
 	if (!ok)
@@ -1334,10 +3020,21 @@ lbool Solver::solve_(/*AB*/bool nosearch/*AE*/) {
 
 	solves++;
 
+	/*AB*/
+	if (!reuseTrail()) {
+		return l_False;
+	}
+	if (packed && decisionLevel() == 1 && !decidePackedAssumptions()) { // (the assumptions that the kept level does not have yet)
+		return l_False;
+	}
+	FlagScope in_search(searching);
+	/*AE*/
+
 	// To get a better estimate of the number of max_learnts allowed, have to ask all propagators their size
 	max_learnts = getPCSolver().getNbOfFormulas() * learntsize_factor;
 	learntsize_adjust_confl = learntsize_adjust_start_confl;
 	learntsize_adjust_cnt = (int) learntsize_adjust_confl;
+	/*A*/if (mem_budget > 0) measureMemory(); // (for the watchers of the clauses added since the last reduction)
 	lbool status = l_Undef;
 
 	/*AB*/
@@ -1351,12 +3048,35 @@ lbool Solver::solve_(/*AB*/bool nosearch/*AE*/) {
 
 	// Search:
 	int curr_restarts = 0;
+	/*A*/int stable_restarts = 0; // (of 'curr_restarts')
 	while (status == l_Undef) {
 		if (terminateRequested()) {
 			return l_Undef;
 		}
-		double rest_base = luby_restart ? luby(restart_inc, curr_restarts) : pow(restart_inc, curr_restarts);
-		status = search(rest_base * restart_first/*AB*/, nosearch/*AE*/);
+		/*AB*/
+		if (exchange != NULL && decisionLevel() > 0 && curr_restarts % 16 == 0) {
+			cancelUntil(0); // NOTE: clauses are only imported at the root, so regularly do a full restart
+		}
+		if (exchange != NULL && decisionLevel() == 0) {
+			importShared();
+			if (!ok) {
+				status = l_False;
+				break;
+			}
+		}
+		/*AE*/
+		/*A*/int focused_restarts = curr_restarts - stable_restarts;
+		double rest_base = luby_restart ? luby(restart_inc, /*A*/focused_restarts) : pow(restart_inc, /*A*/focused_restarts);
+		/*AB*/
+		int nof_conflicts = stable ? luby(2, stable_restarts) * stable_restart_first : glue_restart ? -1 : rest_base * restart_first;
+		uint64_t search_conflicts = conflicts, search_ticks = ticks;
+		/*AE*/
+		status = search(/*A*/nof_conflicts/*AB*/, nosearch/*AE*/);
+		/*AB*/
+		mode_conflicts[stable] += conflicts - search_conflicts;
+		mode_ticks[stable] += ticks - search_ticks;
+		mode_restarts[stable]++;
+		/*AE*/
 		if (terminateRequested()) {
 			return l_Undef;
 		}
@@ -1368,6 +3088,18 @@ lbool Solver::solve_(/*AB*/bool nosearch/*AE*/) {
 		if (!withinBudget())
 			break;
 		curr_restarts++;
+		/*AB*/
+		if (stable) {
+			stable_restarts++;
+		}
+		target_assigned = 0;
+		if (status == l_Undef && rephasing() && conflicts >= next_rephase) {
+			rephase();
+		}
+		if (status == l_Undef && stable_mode == 1 && modeSwitchDue()) {
+			switchMode();
+		}
+		/*AE*/
 	}
 
 	/*AB*/
@@ -1408,6 +3140,317 @@ lbool Solver::solve_(/*AB*/bool nosearch/*AE*/) {
 	return status;
 }
 
+/*AB*/
+//=================================================================================================
+// Search modes and rephasing:
+
+// Focused mode restarts often (Luby or glue based restarts), to learn short clauses quickly, stable mode rarely (Luby
+// with a long unit) and with a slower decay, so it keeps working on one part of the search space. The first focused mode
+// lasts 'mode_init' conflicts, its ticks of search are the length of the next modes, which doubles after each stable mode.
+//
+// Both modes share the two phases: the target phase, of the largest trail since the last restart that led to no conflict,
+// is decided in stable mode (see 'target_mode'), so search returns to an almost satisfying assignment after a restart;
+// the best phase, of the largest such trail since the last rephasing, is one of the phases 'rephase()' resets 'polarity' to.
+void Solver::saveTrailPhases(int confl_level) {
+	int n = trail_lim[confl_level - 1]; // (the trail before the decision of the conflict level was propagated without one)
+	if (targetPhases() && n > target_assigned) {
+		for (int i = 0; i < n; i++) {
+			target_phase[var(trail[i])] = lbool(sign(trail[i]));
+		}
+		target_assigned = n;
+	}
+	if (rephasing() && n > best_assigned) {
+		for (int i = 0; i < n; i++) {
+			best_phase[var(trail[i])] = lbool(sign(trail[i]));
+		}
+		best_assigned = n;
+	}
+}
+
+bool Solver::modeSwitchDue() const {
+	return mode_length == 0 ? mode_conflicts[0] >= (uint64_t) mode_init : mode_ticks[stable] >= mode_end;
+}
+
+void Solver::switchMode() {
+	if (mode_length == 0) {
+		mode_length = mode_ticks[0] > 0 ? mode_ticks[0] : 1;
+	} else if (stable) {
+		mode_length *= 2;
+	}
+	stable = not stable;
+	mode_switches++;
+	mode_end = mode_ticks[stable] + mode_length;
+	if (verbosity >= 2) {
+		std::clog << "c " << (stable ? "stable" : "focused") << " mode for " << mode_length << " ticks, after " << conflicts << " conflicts\n";
+	}
+}
+
+// The phases cycle through original, inverted, then best, walk, original, best, walk, inverted, and so on. The target phase
+// is forgotten, the first decisions after a rephasing follow the new 'polarity'.
+void Solver::rephase() {
+	static const char* schedule = "BWOBWI";
+	char kind = rephases < 2 ? "OI"[rephases] : schedule[(rephases - 2) % 6];
+	rephases++;
+	switch (kind) {
+	case 'O':
+	case 'I':
+		for (Var v = 0; v < nVars(); v++) {
+			polarity[v] = kind == 'O' ? initial_polarity[v] : !initial_polarity[v];
+		}
+		break;
+	case 'B':
+		for (Var v = 0; v < nVars(); v++) {
+			if (best_phase[v] != l_Undef) {
+				polarity[v] = best_phase[v] == l_True;
+			}
+		}
+		break;
+	case 'W':
+		walk();
+		break;
+	}
+	for (Var v = 0; v < nVars(); v++) {
+		target_phase[v] = l_Undef;
+	}
+	target_assigned = best_assigned = 0;
+	next_rephase = conflicts + (uint64_t) rephase_int * (rephases + 1);
+	if (verbosity >= 2) {
+		std::clog << "c rephased (" << kind << ") after " << conflicts << " conflicts\n";
+	}
+}
+
+// ProbSAT: a literal of a random false clause is flipped, with a probability of 'cb^-b' for a literal that would make 'b'
+// clauses false, 'cb' growing with the clause size. It walks over the problem clauses that the root does not satisfy,
+// without their false root literals, not over the other propagators of the PCSolver (the search decides whether the
+// assignment also satisfies them). The flips since the assignment with the fewest false clauses are undone at the end.
+int Solver::walk() {
+	walks++;
+	uint64_t limit = ticks + (uint64_t) (walk_effort * (ticks - walk_ticks));
+	vec<Lit> lits;  // Clause 'i' is 'lits[starts[i]]' .. 'lits[starts[i + 1] - 1]'.
+	vec<int> starts;
+	for (int i = 0; i < clauses.size(); i++) {
+		const Clause& c = ca[clauses[i]];
+		if (c.mark() != 0) {
+			continue;
+		}
+		int start = lits.size();
+		bool satisfied = false;
+		for (int j = 0; j < c.size() && not satisfied; j++) {
+			if (value(c[j]) == l_Undef || level(var(c[j])) > 0) {
+				lits.push(c[j]);
+			} else {
+				satisfied = value(c[j]) == l_True;
+			}
+		}
+		if (satisfied || lits.size() == start) {
+			lits.shrink(lits.size() - start);
+		} else {
+			starts.push(start);
+		}
+	}
+	int nclauses = starts.size();
+	starts.push(lits.size());
+	ticks += lits.size();
+
+	// Occurrences per literal, and the number of true literals of each clause under 'polarity':
+	vec<int> occ_start(2 * nVars() + 1, 0), occs(lits.size());
+	for (int i = 0; i < lits.size(); i++) {
+		occ_start[toInt(lits[i]) + 1]++;
+	}
+	for (int l = 0; l < 2 * nVars(); l++) {
+		occ_start[l + 1] += occ_start[l];
+	}
+	vec<int> fill;
+	occ_start.copyTo(fill);
+	for (int i = 0; i < nclauses; i++) {
+		for (int j = starts[i]; j < starts[i + 1]; j++) {
+			occs[fill[toInt(lits[j])]++] = i;
+		}
+	}
+	vec<char> val(nVars());
+	for (Var v = 0; v < nVars(); v++) {
+		val[v] = !polarity[v];
+	}
+	vec<int> ntrue(nclauses, 0), falses, where(nclauses, -1);
+	for (int i = 0; i < nclauses; i++) {
+		for (int j = starts[i]; j < starts[i + 1]; j++) {
+			ntrue[i] += val[var(lits[j])] ^ sign(lits[j]);
+		}
+		if (ntrue[i] == 0) {
+			where[i] = falses.size();
+			falses.push(i);
+		}
+	}
+
+	// The base of ProbSAT for an average clause size, interpolated between the sizes of 'cbs':
+	static const double cbs[] = { 2.0, 2.0, 2.0, 2.5, 2.85, 3.7, 5.1, 7.4 };
+	double size = nclauses > 0 ? (double) lits.size() / nclauses : 3;
+	int k = size >= 7 ? 6 : (int) size;
+	double cb = cbs[k] + (size >= 7 ? 0 : (size - k) * (cbs[k + 1] - cbs[k]));
+	vec<double> scores;
+	for (double p = 1; p > 1e-300; p /= cb) {
+		scores.push(p);
+	}
+
+	int best = falses.size();
+	vec<Var> since_best;
+	vec<double> weights;
+	while (falses.size() > 0 && ticks < limit) {
+		int ci = falses[irand(random_seed, falses.size())];
+		double sum = 0;
+		weights.clear();
+		for (int j = starts[ci]; j < starts[ci + 1]; j++) {
+			Lit p = lits[j];
+			int breaks = 0;
+			for (int o = occ_start[toInt(~p)]; o < occ_start[toInt(~p) + 1]; o++) {
+				breaks += ntrue[occs[o]] == 1;
+			}
+			ticks += 1 + occ_start[toInt(~p) + 1] - occ_start[toInt(~p)];
+			weights.push(scores[breaks < scores.size() ? breaks : scores.size() - 1]);
+			sum += weights.last();
+		}
+		double r = drand(random_seed) * sum;
+		int j = 0;
+		while (j < weights.size() - 1 && (r -= weights[j]) > 0) {
+			j++;
+		}
+
+		// Flip, 'p' becomes true:
+		Lit p = lits[starts[ci] + j];
+		val[var(p)] ^= 1;
+		walk_flips++;
+		for (int o = occ_start[toInt(p)]; o < occ_start[toInt(p) + 1]; o++) {
+			int c = occs[o];
+			if (ntrue[c]++ == 0) {
+				where[falses.last()] = where[c];
+				falses[where[c]] = falses.last();
+				falses.pop();
+				where[c] = -1;
+			}
+		}
+		for (int o = occ_start[toInt(~p)]; o < occ_start[toInt(~p) + 1]; o++) {
+			int c = occs[o];
+			if (--ntrue[c] == 0) {
+				where[c] = falses.size();
+				falses.push(c);
+			}
+		}
+		ticks += 2 + occ_start[toInt(p) + 1] - occ_start[toInt(p)] + occ_start[toInt(~p) + 1] - occ_start[toInt(~p)];
+		if (falses.size() < best) {
+			best = falses.size();
+			since_best.clear();
+		} else {
+			since_best.push(var(p));
+		}
+	}
+	for (int i = 0; i < since_best.size(); i++) {
+		val[since_best[i]] ^= 1;
+	}
+	for (Var v = 0; v < nVars(); v++) {
+		polarity[v] = !val[v];
+	}
+	walk_ticks = ticks;
+	if (verbosity >= 2) {
+		std::clog << "c walk: " << best << " of " << nclauses << " clauses false, " << walk_flips << " flips in all\n";
+	}
+	return best;
+}
+/*AE*/
+
+/*AB*/
+//=================================================================================================
+// Lookahead:
+
+// The cube is decided one literal per level, then each candidate literal is decided on a level of its own and the
+// literals it propagates are counted. A literal whose propagation fails implies its negation, which is fixed on one
+// more level (or at the root). The variable whose two literals together propagate the most is split on, as in march:
+// the product of the counts favours variables that simplify both branches. Of the two, the literal that propagates
+// the least is returned first: its branch is the smaller simplification, so more likely satisfiable.
+lbool Solver::lookahead(const vec<Lit>& cube, int max_vars, Lit& best) {
+	polarity.copyTo(lookahead_phases);
+	lbool result = lookahead_(cube, max_vars, best);
+	lookahead_phases.copyTo(polarity);
+	return result;
+}
+
+lbool Solver::lookahead_(const vec<Lit>& cube, int max_vars, Lit& best) {
+	best = lit_Undef;
+	if (!ok) {
+		return l_False;
+	}
+	lookaheads++;
+	cancelUntil(0);
+	for (int i = 0; i < cube.size(); i++) {
+		if (value(cube[i]) == l_False) {
+			cancelUntil(0);
+			return l_False;
+		}
+		createNewDecisionLevel();
+		if (value(cube[i]) == l_Undef) {
+			uncheckedEnqueue(cube[i]);
+			if (propagate() != CRef_Undef) {
+				cancelUntil(0);
+				return l_False;
+			}
+		}
+	}
+
+	vec<Var> candidates;
+	for (Var v = 0; v < nVars(); v++) {
+		if (decision[v] && value(v) == l_Undef) {
+			candidates.push(v);
+		}
+	}
+	sort(candidates, [this](Var x, Var y) { return varScore(x) > varScore(y); });
+	if (candidates.size() > max_vars) {
+		candidates.shrink(candidates.size() - max_vars);
+	}
+
+	double best_score = -1;
+	for (int i = 0; i < candidates.size(); i++) {
+		Var v = candidates[i];
+		int props[2] = { 0, 0 };
+		bool failed = false;
+		for (int s = 0; s < 2 && not failed && value(v) == l_Undef; s++) {
+			Lit p = mkLit(v, s);
+			int base = decisionLevel(), start = trail.size();
+			lookahead_probes++;
+			createNewDecisionLevel();
+			uncheckedEnqueue(p);
+			failed = propagate() != CRef_Undef;
+			props[s] = trail.size() - start;
+			cancelUntil(base);
+			if (not failed) {
+				continue;
+			}
+			failed_literals++;
+			if (base == 0) {
+				if (!addClause(~p)) {
+					return l_False;
+				}
+			} else {
+				createNewDecisionLevel();
+				uncheckedEnqueue(~p);
+				if (propagate() != CRef_Undef) {
+					cancelUntil(0);
+					return l_False;
+				}
+			}
+		}
+		if (failed || value(v) != l_Undef) { // (fixed by a failed literal)
+			continue;
+		}
+		double score = 1024.0 * props[0] * props[1] + props[0] + props[1];
+		if (score > best_score) {
+			best_score = score;
+			best = mkLit(v, props[1] < props[0]);
+		}
+	}
+	cancelUntil(0);
+	return l_Undef;
+}
+/*AE*/
+
 //=================================================================================================
 // Writing CNF to DIMACS:
 // 
@@ -1430,7 +3473,21 @@ void Solver::toDimacs(FILE* f, Clause& c, vec<Var>& map, Var& max) {
 }
 
 void Solver::toDimacs(const char *file, const vec<Lit>& assumps) {
-	FILE* f = fopen(file, "wr");
+	/*AB*/
+	int len = strlen(file);
+	if (len > 3 && strcmp(file + len - 3, ".gz") == 0) {
+		gzFile gz = gzopen(file, "wb");
+		if (gz == NULL)
+			fprintf(stderr, "could not open file %s\n", file), exit(1);
+		{
+			WriteBuffer out(gz);
+			toDimacs(out, assumps);
+		}
+		gzclose(gz);
+		return;
+	}
+	/*AE*/
+	FILE* f = fopen(file, "wb");
 	if (f == NULL)
 		fprintf(stderr, "could not open file %s\n", file), exit(1);
 	toDimacs(f, assumps);
@@ -1438,46 +3495,65 @@ void Solver::toDimacs(const char *file, const vec<Lit>& assumps) {
 }
 
 void Solver::toDimacs(FILE* f, const vec<Lit>& assumps) {
+	/*A*/WriteBuffer out(f);
+	/*A*/toDimacs(out, assumps);
+}
+
+/*AB*/
+// The first pass counts the clauses and numbers the variables, so the second only looks them up:
+void Solver::toDimacs(WriteBuffer& out, const vec<Lit>& assumps) {
 	// Handle case when solver is in contradictory state:
 	if (!ok) {
-		fprintf(f, "p cnf 1 2\n1 0\n-1 0\n");
+		out.put("p cnf 1 2\n1 0\n-1 0\n");
 		return;
 	}
 
-	vec<Var> map;
+	vec<Var> map(nVars(), -1);
 	Var max = 0;
 
 	// Cannot use removeClauses here because it is not safe
 	// to deallocate them at this point. Could be improved.
 	int cnt = 0;
-	for (int i = 0; i < clauses.size(); i++)
-		if (!satisfied(ca[clauses[i]]))
-			cnt++;
-
-	for (int i = 0; i < clauses.size(); i++)
-		if (!satisfied(ca[clauses[i]])) {
-			Clause& c = ca[clauses[i]];
-			for (int j = 0; j < c.size(); j++)
-				if (value(c[j]) != l_False)
-					mapVar(var(c[j]), map, max);
-		}
+	for (int i = 0; i < clauses.size(); i++) {
+		const Clause& c = ca[clauses[i]];
+		if (satisfied(c))
+			continue;
+		cnt++;
+		for (int j = 0; j < c.size(); j++)
+			if (value(c[j]) != l_False && map[var(c[j])] == -1)
+				map[var(c[j])] = max++;
+	}
 
 	// Assumptions are added as unit clauses:
 	cnt += assumps.size();
+	for (int i = 0; i < assumps.size(); i++)
+		if (map[var(assumps[i])] == -1)
+			map[var(assumps[i])] = max++;
 
-	fprintf(f, "p cnf %d %d\n", max, cnt);
+	out.put("p cnf "); out.putInt(max); out.put(' '); out.putInt(cnt); out.put('\n');
 
 	for (int i = 0; i < assumps.size(); i++) {
 		assert(value(assumps[i]) != l_False);
-		fprintf(f, "%s%d 0\n", sign(assumps[i]) ? "-" : "", mapVar(var(assumps[i]), map, max) + 1);
+		out.putInt(sign(assumps[i]) ? -(map[var(assumps[i])] + 1) : map[var(assumps[i])] + 1);
+		out.put(" 0\n");
 	}
 
-	for (int i = 0; i < clauses.size(); i++)
-		toDimacs(f, ca[clauses[i]], map, max);
+	for (int i = 0; i < clauses.size(); i++) {
+		const Clause& c = ca[clauses[i]];
+		if (satisfied(c))
+			continue;
+		for (int j = 0; j < c.size(); j++)
+			if (value(c[j]) != l_False) {
+				out.putInt(sign(c[j]) ? -(map[var(c[j])] + 1) : map[var(c[j])] + 1);
+				out.put(' ');
+			}
+		out.put("0\n");
+	}
 
 	if (verbosity > 0)
 		printf("Wrote %d clauses with %d variables.\n", cnt, max);
 }
+/*AE*/
 
 /*AB*/
 void Solver::printClause(CRef rc) const {
@@ -1496,18 +3572,30 @@ void Solver::printClause(CRef rc) const {
 
 //=================================================================================================
 // Garbage Collection methods:
-void Solver::relocAll(ClauseAllocator& to) {
+void Solver::relocAll(ClauseAllocator& to/*AB*/, bool learnts_only/*AE*/) {
+	/*AB*/
+	// With 'learnts_only', the references to problem clauses stay as they are (they are told apart by
+	// their region bit, see 'ClauseAllocator'):
+	auto reloc = [&](CRef& cr) { if (!learnts_only || ClauseAllocator::learntRef(cr)) ca.reloc(cr, to); };
+	/*AE*/
+
 	// All watchers:
 	//
 	// for (int i = 0; i < watches.size(); i++)
 	watches.cleanAll();
+	/*A*/binwatches.cleanAll();
 	for (int v = 0; v < nVars(); v++)
 		for (int s = 0; s < 2; s++) {
 			Lit p = mkLit(v, s);
 			// printf(" >>> RELOCING: %s%d\n", sign(p)?"-":"", var(p)+1);
 			vec<Watcher>& ws = watches[p];
 			for (int j = 0; j < ws.size(); j++)
-				ca.reloc(ws[j].cref, to);
+				/*A*/reloc(ws[j].cref);
+			/*AB*/
+			vec<BinWatcher>& bws = binwatches[p];
+			for (int j = 0; j < bws.size(); j++)
+				reloc(bws[j].cref);
+			/*AE*/
 		}
 
 	// All reasons:
@@ -1515,79 +3603,228 @@ void Solver::relocAll(ClauseAllocator& to) {
 	for (int i = 0; i < trail.size(); i++) {
 		Var v = var(trail[i]);
 
-		if (reason(v) != CRef_Undef && (ca[reason(v)].reloced() || locked(ca[reason(v)])))
+		if (reason(v) != CRef_Undef && /*A*/(!learnts_only || ClauseAllocator::learntRef(reason(v))) && (ca[reason(v)].reloced() || locked(ca[reason(v)])))
 			ca.reloc(vardata[v].reason, to);
 	}
 
 	// All learnt:
 	//
-	for (int i = 0; i < learnts.size(); i++)
-		ca.reloc(learnts[i], to);
+	for (int i = 0; i < learnts_core.size(); i++)
+		/*A*/reloc(learnts_core[i]);
+	for (int i = 0; i < learnts_mid.size(); i++)
+		/*A*/reloc(learnts_mid[i]);
+	for (int i = 0; i < learnts_local.size(); i++)
+		/*A*/reloc(learnts_local[i]);
 
 	// All original:
 	//
 	for (int i = 0; i < clauses.size(); i++)
-		ca.reloc(clauses[i], to);
+		/*A*/reloc(clauses[i]);
+
+	/*AB*/
+	// Clauses waiting for inprocessing (possibly removed meanwhile):
+	int i, j;
+	for (i = j = 0; i < inprocess_queue.size(); i++)
+		if (ca[inprocess_queue[i]].mark() == 0) {
+			reloc(inprocess_queue[i]);
+			inprocess_queue[j++] = inprocess_queue[i];
+		}
+	inprocess_queue.shrink(i - j);
+	for (i = j = 0; i < added_above_root.size(); i++)
+		if (ca[added_above_root[i]].mark() == 0) {
+			reloc(added_above_root[i]);
+			added_above_root[j++] = added_above_root[i];
+		}
+	added_above_root.shrink(i - j);
+	/*AE*/
 }
 
 void Solver::garbageCollect() {
+	/*A*/StatTimer timer(stats, st_collect);
 	// Initialize the next region to a size corresponding to the estimated utilization degree. This
 	// is not precise but should avoid some unnecessary reallocations for the new region:
-	ClauseAllocator to(ca.size() - ca.wasted());
+	ClauseAllocator to(/*A*/ca.size(false) - ca.wasted(false), ca.size(true) - ca.wasted(true));
 
 	relocAll(to);
 	if (verbosity >= 2)
-		fprintf(stderr, "|  Garbage collection:   %12d bytes => %12d bytes             |\n", ca.size() * ClauseAllocator::Unit_Size,
-				to.size() * ClauseAllocator::Unit_Size);
+		fprintf(stderr, "|  Garbage collection:   %12" PRIu64 " bytes => %12" PRIu64 " bytes             |\n",
+				(uint64_t) ca.size() * ClauseAllocator::Unit_Size, (uint64_t) to.size() * ClauseAllocator::Unit_Size);
+	to.moveTo(ca);
+	/*A*/garbage_collections++;
+	/*AB*/
+	if (mem_budget > 0) { // (the lists were cleaned by 'relocAll()', after a reduction many use a fraction of what they grew to)
+		watches.trim();
+		binwatches.trim();
+	}
+	measureMemory();
+	/*AE*/
+}
+
+/*AB*/
+void Solver::collectLearnts() {
+	StatTimer timer(stats, st_collect);
+	ClauseAllocator to(0, ca.size(true) - ca.wasted(true));
+
+	relocAll(to, true);
+	if (verbosity >= 2)
+		fprintf(stderr, "|  Learnt collection:    %12" PRIu64 " bytes => %12" PRIu64 " bytes             |\n",
+				(uint64_t) ca.size(true) * ClauseAllocator::Unit_Size, (uint64_t) to.size(true) * ClauseAllocator::Unit_Size);
+	ca.moveProblemClausesTo(to);
 	to.moveTo(ca);
+	learnt_collections++;
+	if (mem_budget > 0) {
+		watches.trim();
+		binwatches.trim();
+	}
+	measureMemory();
 }
+/*AE*/
 
 /*AB*/
 void Solver::printStatistics() const {
 	std::clog << "> restarts              : " << starts << "\n";
-	std::clog << "> conflicts             : " << decisions << "  (" << (float) rnd_decisions * 100 / (float) decisions << " % random)\n";
-	std::clog << "> decisions             : " << starts << "\n";
+	std::clog << "> conflicts             : " << conflicts << "\n";
+	std::clog << "> decisions             : " << decisions << "  (" << (float) rnd_decisions * 100 / (float) decisions << " % random)\n";
 	std::clog << "> propagations          : " << propagations << "\n";
+	std::clog << "> ticks                 : " << ticks << "\n";
 	std::clog << "> conflict literals     : " << tot_literals << "  (" << ((max_literals - tot_literals) * 100 / (double) max_literals) << " % deleted)\n";
+	std::clog << "> learnt clauses        : " << nLearnts() << "  (" << learnts_core.size() << " core, " << learnts_mid.size() << " mid, " << learnts_local.size() << " local)\n";
+	if (chrono >= 0) {
+		std::clog << "> chrono backtracks     : " << chrono_backtracks << "\n";
+	}
+	if (bin_minimized + otf_strengthened > 0) {
+		std::clog << "> learnt minimization   : " << bin_minimized << " literals removed by binary clauses, " << otf_strengthened << " reasons strengthened\n";
+	}
+	if (inprocessings > 0) {
+		std::clog << "> inprocessing          : " << inprocessings << " rounds, " << inproc_subsumed << " subsumed, " << inproc_strengthened
+				<< " strengthened, " << inproc_vivified << " literals vivified away\n";
+	}
+	if (lookaheads > 0) {
+		std::clog << "> lookahead             : " << lookaheads << " lookaheads, " << lookahead_probes << " probes, " << failed_literals << " failed literals\n";
+	}
+	if (stable_mode > 0) {
+		for (int m = 0; m < 2; m++) {
+			std::clog << (m == 0 ? "> focused mode          : " : "> stable mode           : ") << mode_conflicts[m] << " conflicts, " << mode_restarts[m] << " restarts, "
+					<< mode_ticks[m] << " ticks\n";
+		}
+		std::clog << "> rephasing             : " << mode_switches << " mode switches, " << rephases << " rephases, " << walks << " walks (" << walk_flips << " flips)\n";
+	}
+	if (glue_restart || partial_restart) {
+		std::clog << "> restart reuse         : " << blocked_restarts << " blocked, " << reused_levels << " decision levels reused\n";
+	}
+	if (garbage_collections + learnt_collections > 0) {
+		std::clog << "> garbage collections   : " << garbage_collections << " full, " << learnt_collections << " learnt only\n";
+	}
+	std::clog << "> memory (MB)           : " << (double) ca.size() * ClauseAllocator::Unit_Size / (1 << 20) << " clauses, "
+			<< (double) (watches.bytes() + binwatches.bytes()) / (1 << 20) << " watchers, " << memUsed() << " process";
+	if (mem_budget > 0) {
+		std::clog << "  (budget " << (mem_budget >> 20) << ", the learnt clause limit lowered " << memory_reductions << " times)";
+	}
+	std::clog << "\n";
+	if (shared_exported + shared_imported > 0) {
+		std::clog << "> shared clauses        : " << shared_exported << " exported, " << shared_imported << " imported (" << shared_useful << " useful)\n";
+	}
+#ifndef MINISAT_NO_STATS
+	std::clog << "> time (s)              :";
+	for (int t = 0; t < stats.nTimers(); t++) {
+		std::clog << (t == 0 ? " " : ", ") << stats.timerName(t) << " " << stats.timerSeconds(t);
+	}
+	std::clog << "\n";
+#endif
+}
+
+void Solver::recordProgress() {
+	/*A*/measureMemory();
+	double row[] = { (double) conflicts, (double) decisions, (double) propagations, (double) starts,
+			(double) (trail_lim.size() == 0 ? trail.size() : trail_lim[0]), (double) nClauses(), (double) nLearnts(), max_learnts, (double) arena_bytes, (double) watch_bytes, progressEstimate() };
+	stats.record(row);
 }
 
-int Solver::printECNF(std::ostream& stream, std::set<Var>& printedvars) {
+void Solver::writeStats() {
+	/*A*/measureMemory();
+	const char* file = stats_file != NULL ? stats_file : "-";
+	if (!stats.writeJSON(file)) {
+		fprintf(stderr, "could not write the statistics to %s\n", file);
+	}
+}
+
+bool Solver::openProof(const char* file) {
+	return proof.open(file);
+}
+
+// Before the first clause (or 'solve()'), so that the proof has every step of the simplification.
+void Solver::openDratFile() {
+	const char* file = drat_file;
+	drat_file = NULL; // (tried once)
+	if (file == (const char*) opt_drat_file && drat_claimed.exchange(true)) {
+		return; // (another solver of this process writes it)
+	}
+	if (!proof.isOpen() && !openProof(file)) {
+		fprintf(stderr, "could not open the proof file %s\n", file);
+	}
+}
+
+bool Solver::closeProof() {
+	if (!proof.isOpen()) {
+		return true;
+	}
+	if (!ok) {
+		vec<Lit> empty;
+		proof.add(empty);
+	}
+	if (!proof.close()) {
+		fprintf(stderr, "could not write the whole proof\n");
+		return false;
+	}
+	return true;
+}
+
+int Solver::printECNF(std::ostream& stream, std::set<Var>& printedvars, bool delta) {
+	WriteBuffer out(stream);
 	if (not okay()) {
-		stream << "0\n";
+		out.put("0\n");
 		return 0;
 	}
-	for (int i = 0; i < clauses.size(); ++i) {
+	int lastrootassertion = trail.size();
+	if (trail_lim.size() > 0) {
+		lastrootassertion = trail_lim[0];
+	}
+	int firstclause = delta ? export_clauses : 0;
+	int firstroot = delta ? std::min(export_roots, lastrootassertion) : 0;
+	vec<char> printed(nVars(), 0); // (added to 'printedvars' at the end, in order, instead of one set insertion per literal)
+
+	for (int i = firstclause; i < clauses.size(); ++i) {
 		const Clause& clause = ca[clauses[i]];
-		stringstream ss;
-		bool clausetrue = false;
-		for (int j = 0; not clausetrue && j < clause.size(); ++j) {
+		if (satisfied(clause)) {
+			continue;
+		}
+		for (int j = 0; j < clause.size(); ++j) {
 			Lit lit = clause[j];
-			lbool val = value(lit);
-			if (val == l_Undef) {
-				ss << (sign(lit) ? -(var(lit) + 1) : var(lit) + 1) << " ";
-				printedvars.insert(var(lit));
-			} else if (val == l_True) {
-				clausetrue = true;
+			if (value(lit) == l_Undef) {
+				out.putInt(sign(lit) ? -(var(lit) + 1) : var(lit) + 1);
+				out.put(' ');
+				printed[var(lit)] = 1;
 			}
 		}
-		if (not clausetrue) {
-			ss << "0\n";
-			stream << ss.str();
-		}
+		out.put("0\n");
 	}
 
 	// Print implied literals
-	int lastrootassertion = trail.size();
-	if (trail_lim.size() > 0) {
-		lastrootassertion = trail_lim[0];
-	}
-	for (int i = 0; i < lastrootassertion; ++i) {
+	for (int i = firstroot; i < lastrootassertion; ++i) {
 		Lit lit = trail[i];
 		// TODO should only print literals which have a translation?
-		stream << (sign(lit) ? -(var(lit) + 1) : var(lit) + 1) << " 0\n";
+		out.putInt(sign(lit) ? -(var(lit) + 1) : var(lit) + 1);
+		out.put(" 0\n");
 	}
 
-	return clauses.size() + lastrootassertion;
+	for (Var v = 0; v < nVars(); v++) {
+		if (printed[v]) {
+			printedvars.insert(printedvars.end(), v);
+		}
+	}
+	export_clauses = clauses.size();
+	export_roots = lastrootassertion;
+	return clauses.size() - firstclause + lastrootassertion - firstroot;
 }
 
 /*AE*/
@@ -23,10 +23,16 @@ OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWA
 
 #include "mtl/Vec.h"
 #include "mtl/Heap.h"
+/*A*/#include "mtl/QuadHeap.h"
 #include "utils/Options.h"
+/*A*/#include "utils/WriteUtils.h"
+/*A*/#include "utils/Stats.h"
 #include "core/SolverTypes.h"
+/*A*/#include "core/Heuristics.h"
+/*A*/#include "core/Drat.h"
 
 /*AB*/
+#include <atomic>
 #include <vector>
 #include <iostream>
 #include <set>
@@ -41,6 +47,17 @@ namespace MinisatID{
 
 namespace Minisat {
 
+/*A*/class ClauseExchange;
+/*AB*/
+class GaussPropagator;
+
+// An XOR constraint: the sum of 'vars' modulo 2 is 'rhs'.
+struct Xor {
+    std::vector<Var> vars;
+    bool             rhs;
+};
+/*AE*/
+
 //=================================================================================================
 // Solver -- the main class:
 
@@ -51,29 +68,34 @@ private:
 public:
 /*AB*/
 	bool		handleConflict(CRef conflict);
-	void 		setInitialPolarity(Var  var, bool pol) { polarity[var] = pol; }
-	std::vector<Lit> rootunitlits;	// basic reverse trail for unit clauses
+	void 		setInitialPolarity(Var  var, bool pol) { polarity[var] = pol; /*A*/initial_polarity[var] = pol; }
+	std::vector<Lit> rootunitlits;	// basic reverse trail for unit clauses /*A*/(enqueued again after backtracking; units added above the root are root literals on the trail instead, see 'injectClause()')
 	// Symmetry code
 	bool		isDecision			(const Lit& lit) const { return (getLevel(var(lit))!=0 && lit==trail[trail_lim[getLevel(var(lit))-1]]); }
 	CRef		reason				(Var x) const;
 
 	bool		isUnsat				() const { return not ok; }
 	void 		notifyUnsat			() { ok = false; }
-	int			printECNF			(std::ostream& stream, std::set<Var>& printedvars); // Returns the number of clauses that were added
-	void		saveState			();
-	void		resetState			();
+	int			printECNF			(std::ostream& stream, std::set<Var>& printedvars/*AB*/, bool delta = false/*AE*/); // Returns the number of clauses that were added
+																	// With 'delta', only the clauses and root literals added since the previous call are printed.
+	void		saveState			();						// Close all checkpoints and open a new one.
+	void		resetState			();						// Roll back to the innermost checkpoint.
+	int			pushCheckpoint		();						// Open a (nested) checkpoint, returns the number of open checkpoints.
+	void		rollbackCheckpoint	();						// Undo all changes since the innermost checkpoint, which stays open.
+	void		popCheckpoint		();						// Close the innermost checkpoint, keeping all changes since.
+	int			nbCheckpoints		()				const	{ return checkpoints.size(); }
 	void     	printClause			(const CRef c) 	const;
 	bool    	addBinaryOrLargerClause	(vec<Lit>& ps, CRef& newclause);
 	void		addLearnedClause	(CRef c);					// don't check anything, just add it to the clauses and bump activity
 	void     	removeClause     	(CRef cr);					// Detach and free a clause.
-	CRef		makeClause			(const vec<Lit>& lits, bool b){ return ca.alloc(lits, b); }
+	CRef		makeClause			(const vec<Lit>& lits, bool b){ CRef cr = ca.alloc(lits, b); ca[cr].epoch(epoch); return cr; }
 	CRef	 	getClause			(int i) 		const 	{ return clauses[i]; }
 	int			nbClauses			() 				const 	{ return clauses.size(); }
 	int			getClauseSize		(CRef cr) 		const 	{ return ca[cr].size(); }
 	Lit			getClauseLit		(CRef cr, int i) const 	{ assert(0<=i && i<getClauseSize(cr)); return ca[cr][i]; }
 
 	void		cancelUntil			(int level);				// Backtrack until a certain level.
-	void		uncheckedEnqueue	(Lit p, CRef from = CRef_Undef); // Enqueue a literal. Assumes value of literal is undefined
+	void		uncheckedEnqueue	(Lit p, CRef from = CRef_Undef, Lit binother = lit_Undef, int lvl = -1); // Enqueue a literal (at level 'lvl', default the current one). Assumes value of literal is undefined
 	void		checkedEnqueue		(Lit p, CRef from = CRef_Undef); // Enqueue a literal if it is not already true
 	int 		getLevel			(int var)		const;
 	bool 		totalModelFound		();							// True if the current assignment is completely two-valued
@@ -83,7 +105,15 @@ public:
 	int		 	getTrailSize		()				const 	{ return trail.size(); }
 	const Lit& 	getTrailElem		(int index)		const 	{ return trail[index]; }
 	int 		getStartLastLevel	()				const 	{ return trail_lim.size()==0?0:trail_lim.last(); }
-	void     	varBumpActivity		(Var v);					// Increase a variable with the current 'bump' value.
+	// Batched notifications (opt-in): no notifySetTrue() per assigned literal, instead every propagator keeps its own
+	// queue head into the trail and fetches the literals assigned since its previous call as one contiguous slice.
+	// This only takes effect once all of the 'propagators' (there are as many as were registered with the PCSolver)
+	// have a queue head, until then every assignment is still notified. Set before the search, 0 switches it off.
+	void		setBatchedNotify	(int propagators)		{ batch_propagators = propagators; batched_notify = propagators > 0 && trail_heads.size() >= propagators; }
+	bool		batchedNotify		()				const	{ return batched_notify; } // Whether it took effect.
+	int			newTrailHead		()						{ trail_heads.push(0); setBatchedNotify(batch_propagators); return trail_heads.size()-1; } // Returns the id of a new queue head, at the start of the trail.
+	int			trailSlice			(int head, const Lit*& lits); // Points 'lits' to the literals not yet seen by 'head' (valid until the next 'newVar()') and returns their number.
+	void     	varBumpActivity		(Var v);					// Increase a variable with the current 'bump' value (of the selected heuristic).
 	bool 		isDecision			(Lit& l) 		const	{ return (getLevel(var(l))!=0 && l==trail[trail_lim[getLevel(var(l))-1]]); }
 
 	uint64_t    nbVars				()				const;					// The current number of variables.
@@ -99,7 +129,7 @@ public:
 
 	//PROPAGATOR CODE
 	const char* getName				() 				const	{ return "satsolver"; }
-	CRef 		getExplanation		(const Lit& l) 			{ return reason(var(l));}
+	CRef 		getExplanation		(const Lit& l);
 	void 		finishParsing		(bool& present);
 	void 		notifyBacktrack		(int untillevel, const Lit& decision) { Propagator::notifyBacktrack(untillevel, decision); }
 	CRef 		notifypropagate		();
@@ -115,14 +145,20 @@ public:
     // Problem specification:
     //
     Var     newVar    (lbool upol = l_Undef, bool dvar = true); // Add a new variable with parameters specifying variable mode.
+    /*A*/void    reserve   (int nvars, int nclauses, uint64_t nlits); // Pre-size for a problem of this size (a hint, e.g. from a DIMACS header).
 
     bool    addClause (const vec<Lit>& ps);                     // Add a clause to the solver. 
     bool    addEmptyClause();                                   // Add the empty clause, making the solver contradictory.
     bool    addClause (Lit p);                                  // Add a unit clause to the solver. 
     bool    addClause (Lit p, Lit q);                           // Add a binary clause to the solver. 
     bool    addClause (Lit p, Lit q, Lit r);                    // Add a ternary clause to the solver. 
-    bool    addClause_(vec<Lit>& ps);							// Add a clause to the solver without making superflous internal copy. Will
-                                                                // change the passed vector 'ps'.
+    bool    addClause_(vec<Lit>& ps/*AB*/, bool imported = false, int glue = 0/*AE*/);	// Add a clause to the solver without making superflous internal copy. Will
+                                                                // change the passed vector 'ps'. Imported clauses are added as learnt clauses.
+    /*AB*/
+    bool    addClauses(const vec<Lit>& lits, const vec<int>& offsets); // Add many problem clauses at once: clause 'i' is 'lits[offsets[i] .. offsets[i+1])'.
+                                                                // At the root level, all are attached before propagating and simplifying once.
+    bool    injectClause(vec<Lit>& ps);                         // Add a problem clause above the root level (what 'addClause_()' does there): see 'Solver.cc'.
+    /*AE*/
 
     // Solving:
     //
@@ -138,16 +174,35 @@ public:
     void    toDimacs     (FILE* f, const vec<Lit>& assumps);            // Write CNF to file in DIMACS-format.
     void    toDimacs     (const char *file, const vec<Lit>& assumps);
     void    toDimacs     (FILE* f, Clause& c, vec<Var>& map, Var& max);
+    /*A*/void    toDimacs     (WriteBuffer& out, const vec<Lit>& assumps);     // (A 'file' ending in '.gz' is written compressed.)
 
     // Convenience versions of 'toDimacs()':
     void    toDimacs     (const char* file);
     void    toDimacs     (const char* file, Lit p);
     void    toDimacs     (const char* file, Lit p, Lit q);
     void    toDimacs     (const char* file, Lit p, Lit q, Lit r);
+
+    /*AB*/
+    // Binary snapshot of the root level state, to start again from where a previous solver stopped
+    // (see 'Snapshot.cc'):
+    bool    writeSnapshot (const char* file);          // False if the file cannot be written or checkpoints are open.
+    bool    readSnapshot  (const char* file);          // Into a solver without variables and clauses. False if 'file' is not a snapshot of this version and heuristic.
+
+    void    writeStats    ();                          // Write 'stats' to 'stats_file' (or standard error). Also done at the end of 'solve()' and on SIGUSR1.
+
+    // Binary DRAT proof of the clauses learnt and deleted (see 'DratWriter'), also opened with 'drat_file' by the first 'addClause()' or 'solve()':
+    bool    openProof     (const char* file);          // False if the file cannot be created.
+    bool    closeProof    ();                          // Ends with the empty clause if the solver is unsatisfiable. False if anything could not be written. Also done by the destructor.
+    bool    proofEnabled  ()  const { return proof.isOpen(); }
+    /*AE*/
     
     // Variable mode:
     // 
     void    setPolarity    (Var v, lbool b); // Declare which polarity the decision heuristic should use for a variable. Requires mode 'polarity_user'.
+    /*AB*/
+    void    setHeuristic   (int h);          // 'heur_vsids', 'heur_vmtf' or 'heur_chb' (default '-heuristic'). Only before the first variable.
+    int     getHeuristic   ()      const { return heuristic; }
+    /*AE*/
 
     // Read state:
     //
@@ -168,10 +223,30 @@ public:
     void    budgetOff();
     void    interrupt();          // Trigger a (potentially asynchronous) interruption of the solver.
     void    clearInterrupt();     // Clear interrupt indicator flag.
+    /*AB*/
+    void    setTickBudget(int64_t x);      // A budget of 'ticks': reproducible, and closer to the time taken than conflicts or propagations.
+    void    setDeadline  (double seconds); // Stop after 'seconds' of wall-clock time from now (monotonic). Both are cleared by 'budgetOff()'.
+    /*AE*/
+
+    /*AB*/
+    // Clause sharing: learnt units, binaries and clauses with a glue of at most 'share_lbd' are exported to
+    // the other solvers of a portfolio, whose clauses are imported at restarts. 'id' is the thread number.
+    void    setClauseExchange(ClauseExchange* x, int id) { exchange = x; exchange_id = id; }
+
+    // XOR constraints encoded by problem clauses of at most 'max_size' literals (each needs all 2^(size-1) clauses):
+    void    findXors     (std::vector<Xor>& xors, int max_size) const;
+
+    // Lookahead for cube-and-conquer (see 'Cubes.h'): probes both literals of the 'max_vars' most active unassigned
+    // variables under the assumptions 'cube', and sets 'best' to the literal to split on next (or 'lit_Undef' if none is
+    // left). Failed literals are fixed, at the root if 'cube' is empty. l_False if 'cube' is refuted. Ends at the root, with
+    // the saved phases of before.
+    lbool   lookahead    (const vec<Lit>& cube, int max_vars, Lit& best);
+    /*AE*/
 
     // Memory managment:
     //
     virtual void garbageCollect();
+    /*A*/void    collectLearnts();     // Compact only the region of the learnt clauses.
     void    checkGarbage(double gf);
     void    checkGarbage();
 
@@ -197,12 +272,49 @@ public:
 
     int       restart_first;      // The initial restart limit.                                                                (default 100)
     double    restart_inc;        // The factor with which the restart limit is multiplied in each restart.                    (default 1.5)
+    /*AB*/
+    bool      glue_restart;       // Restart when recent glue is high compared to the long-term average, instead of Luby/geometric.(default false)
+    double    restart_margin;     // Restart if the fast glue average exceeds the slow one by this factor.                     (default 1.25)
+    int       restart_min;        // Minimal number of conflicts between two glue based restarts.                              (default 50)
+    double    block_margin;       // Block a restart if the trail is this factor longer than its average (0 = never block).     (default 1.4)
+    int       block_after;        // Do not block restarts during the first conflicts.                                         (default 10000)
+    bool      partial_restart;    // On restart, only backtrack to the first decision less active than the next decision.      (default false)
+    bool      reuse_assumps;      // Keep the levels of the assumptions that a call to 'solve()' shares with the last one.     (default true)
+    bool      pack_assumps;       // Put all assumptions on decision level 1 instead of one level each.                        (default false)
+    int       chrono;             // Backtrack chronologically if a backjump would undo more levels than this (-1 = never).   (default -1)
+    int       chrono_after;       // Do not backtrack chronologically during the first conflicts.                              (default 4000)
+    int       bin_min;            // Minimize learnt clauses with at most this glue with binary clauses (0 = never).          (default 6)
+    bool      otfs;               // Strengthen reasons subsumed by an intermediate resolvent of conflict analysis.            (default true)
+    bool      use_inprocess;      // Periodically simplify the clause database at the root level during search.                (default false)
+    int       inprocess_int;      // Conflicts before the first inprocessing round, the interval grows linearly.               (default 10000)
+    double    inprocess_frac;     // Inprocessing effort as a fraction of the propagations of search since the last round.   (default 0.1)
+    bool      gauss;              // Detect XOR constraints when parsing is finished and propagate them by Gauss-Jordan elimination. (default false)
+    int       xor_size;           // Maximal size of the XOR constraints to detect.                                            (default 5)
+    const char* stats_file;       // Write 'stats' as JSON to this file ("-" for standard error) when done or when asked by a signal. (default none)
+    const char* drat_file;        // Open this proof file on the first 'addClause()' or 'solve()'. Of all solvers, only one opens that of '-drat'. (default none)
+    int       stats_interval;     // Record a row of the time series of 'stats' every this many conflicts, instead of the progress table (0 = never). (default 0)
+    uint64_t  mem_budget;         // Bytes that the clauses and their watchers should fit in, the learnt clauses give way as they near it (0 = none). (default 0)
+    int       stable_mode;        // Search modes: 0 = focused only, 1 = alternate focused and stable, 2 = stable only.         (default 0)
+    int       mode_init;          // Conflicts of the first focused mode, its ticks are the length of the next modes.         (default 1000)
+    int       stable_restart_first; // The Luby unit of the restart intervals of stable mode, in conflicts.                  (default 1024)
+    double    stable_var_decay;   // The variable activity decay factor of stable mode.                                        (default 0.975)
+    int       target_mode;        // Decide the target phase: 0 = never, 1 = in stable mode, 2 = in both modes.              (default 1)
+    int       rephase_int;        // Conflicts between two rephasings when the modes are on, the interval grows linearly (0 = never). (default 1000)
+    double    walk_effort;        // Ticks of the random walk of a rephasing, as a fraction of the ticks of search since the last one. (default 0.1)
+    /*AE*/
     double    learntsize_factor;  // The intitial limit for learnt clauses is a factor of the original clauses.                (default 1 / 3)
     double    learntsize_inc;     // The limit for learnt clauses is multiplied with this factor each restart.                 (default 1.1)
 
     int       learntsize_adjust_start_confl;
     double    learntsize_adjust_inc;
 
+    /*AB*/
+    int       core_lbd;           // Learnt clauses with at most this glue are never removed.                                  (default 2)
+    int       mid_lbd;            // Learnt clauses with at most this glue are kept as long as they keep being used.           (default 6)
+    bool      lazy_decidable;     // Only make variables decidable once a clause needs them to be chosen.                      (default true)
+    int       share_lbd;          // Learnt clauses with at most this glue are shared with the other solvers of a portfolio.  (default 3)
+    /*AE*/
+
     bool		usecustomheur;
     double		customheurfreq;
 
@@ -212,6 +324,20 @@ public:
     //
     uint64_t solves, starts, decisions, rnd_decisions, propagations, conflicts;
     uint64_t dec_vars, clauses_literals, learnts_literals, max_literals, tot_literals;
+    /*A*/uint64_t shared_exported, shared_imported, shared_useful;
+    /*A*/uint64_t blocked_restarts, reused_levels;
+    /*A*/uint64_t reused_assumption_levels, repaired_clauses;
+    /*A*/uint64_t chrono_backtracks;
+    /*A*/uint64_t bin_minimized, otf_strengthened;
+    /*A*/uint64_t inprocessings, inproc_subsumed, inproc_strengthened, inproc_vivified;
+    /*A*/uint64_t lookaheads, lookahead_probes, failed_literals;
+    /*A*/uint64_t mode_conflicts[2], mode_restarts[2], mode_ticks[2]; // Of search, per mode: indexed by 'stable'.
+    /*A*/uint64_t mode_switches, rephases, walks, walk_flips;
+    /*A*/uint64_t ticks;        // Units of work of about one memory access: watchers visited, clauses and their literals scanned, analysis steps.
+    /*A*/uint64_t garbage_collections, learnt_collections;
+    /*A*/uint64_t arena_bytes, watch_bytes, memory_reductions; // (the watchers as of the last reduction or collection)
+    /*A*/StatsRegistry stats;       // All of the above, and timers and counters of the hot paths (see 'Solver()').
+    /*A*/DratWriter    proof;       // Closed unless a proof was asked for.
 
 protected:
 	void    	varDecayActivity	();							// Decay all variables with the specified factor. Implemented by increasing the 'bump' value instead.
@@ -223,8 +349,9 @@ protected:
 
     // Helper structures:
     //
-    struct VarData { CRef reason; int level; };
-    static inline VarData mkVarData(CRef cr, int l){ VarData d = {cr, l}; return d; }
+    struct VarData { CRef reason; Lit binother; int level; }; // 'binother' is the false literal of a binary reason, lit_Undef otherwise.
+    static inline VarData mkVarData(CRef cr, int l){ VarData d = {cr, lit_Undef, l}; return d; }
+    static inline VarData mkVarData(CRef cr, Lit other, int l){ VarData d = {cr, other, l}; return d; }
 
     struct Watcher {
         CRef cref;
@@ -234,41 +361,110 @@ protected:
         bool operator!=(const Watcher& w) const { return cref != w.cref; }
     };
 
+    /*AB*/
+    // Binary clauses are watched separately: the implied literal is stored inline, so propagating
+    // them never touches the clause arena.
+    struct BinWatcher {
+        CRef cref;
+        Lit  implied;
+        BinWatcher(CRef cr, Lit p) : cref(cr), implied(p) {}
+        bool operator==(const BinWatcher& w) const { return cref == w.cref; }
+        bool operator!=(const BinWatcher& w) const { return cref != w.cref; }
+    };
+    /*AE*/
+
     struct WatcherDeleted
     {
         const ClauseAllocator& ca;
         WatcherDeleted(const ClauseAllocator& _ca) : ca(_ca) {}
         bool operator()(const Watcher& w) const { return ca[w.cref].mark() == 1; }
+        /*A*/bool operator()(const BinWatcher& w) const { return ca[w.cref].mark() == 1; }
     };
 
     struct VarOrderLt {
         const vec<double>&  activity;
         bool operator () (Var x, Var y) const { return activity[x] > activity[y]; }
         VarOrderLt(const vec<double>&  act) : activity(act) { }
+        /*AB*/
+        typedef double Key; // For 'QuadHeap'
+        Key  key    (Var x)        const { return activity[x]; }
+        bool better (Key a, Key b) const { return a > b; }
+        /*AE*/
     };
 
+    /*AB*/
+    // Build with -D MINISAT_QUAD_HEAP to use the 4-ary heap with inline keys.
+#ifdef MINISAT_QUAD_HEAP
+    typedef QuadHeap<VarOrderLt> OrderHeap;
+#else
+    typedef Heap<VarOrderLt>     OrderHeap;
+#endif
+    /*AE*/
+
     // Solver state:
     //
     bool                ok;               // If FALSE, the constraints are already unsatisfiable. No part of the solver state may be used!
     vec<CRef>           clauses;          // List of problem clauses.
-    vec<CRef>           learnts;          // List of learnt clauses.
+    /*AB*/
+    enum { tier_core = 0, tier_mid = 1, tier_local = 2 };
+    vec<CRef>           learnts_core;     // Learnt clauses with a low glue, kept forever.
+    vec<CRef>           learnts_mid;      // Learnt clauses with a moderate glue, demoted to 'learnts_local' when they are no longer used.
+    vec<CRef>           learnts_local;    // Remaining learnt clauses, halved by activity in 'reduceDB()'.
+    /*AE*/
     double              cla_inc;          // Amount to bump next clause with.
-    vec<double>         activity;         // A heuristic measurement of the activity of a variable.
+    vec<double>         activity;         // A heuristic measurement of the activity of a variable (the CHB score for 'heur_chb').
+    /*AB*/
+    int                 heuristic;        // Decision heuristic (see 'setHeuristic()'), fixed once there are variables: only those of 'heur_vmtf' are in 'vmtf'.
+    VmtfQueue           vmtf;             // Decision order for 'heur_vmtf', which does not use 'order_heap'.
+    vec<uint64_t>       chb_conflict;     // For 'heur_chb', the last conflict in which a variable took part.
+    double              chb_alpha;        // For 'heur_chb', the step size, decreasing from 0.4 to 0.06.
+    /*AE*/
     double              var_inc;          // Amount to bump next variable with.
     OccLists<Lit, vec<Watcher>, WatcherDeleted>
                         watches;          // 'watches[lit]' is a list of constraints watching 'lit' (will go there if literal becomes true).
+    /*AB*/
+    OccLists<Lit, vec<BinWatcher>, WatcherDeleted>
+                        binwatches;       // 'binwatches[lit]' lists the binary clauses that become unit if 'lit' becomes true.
+    /*AE*/
     vec<lbool>          assigns;          // The current assignments.
     vec<char>           polarity;         // The preferred polarity of each variable.
     vec<lbool>          user_pol;         // The users preferred polarity of each variable.
+    /*AB*/
+    vec<char>           initial_polarity; // 'polarity' as given by 'setInitialPolarity()', for the original and the inverted rephasing.
+    vec<lbool>          target_phase;     // The signs of the largest conflict-free trail since the last restart ('l_True' is a negative literal, as in 'user_pol').
+    vec<lbool>          best_phase;       // The same since the last rephasing.
+    int                 target_assigned;  // The sizes of these trails.
+    int                 best_assigned;
+    bool                stable;           // In stable mode (see 'stable_mode'), otherwise in focused mode.
+    uint64_t            mode_length;      // Ticks of search of a mode, 0 until the end of the first focused mode.
+    uint64_t            mode_end;         // The value of 'mode_ticks[stable]' at which the current mode ends.
+    uint64_t            next_rephase;     // Number of conflicts before the next rephasing.
+    uint64_t            walk_ticks;       // The value of 'ticks' at the end of the last random walk.
+    /*AE*/
     vec<char>           decision;         // Declares if a variable is eligible for selection in the decision heuristic.
+    /*A*/vec<Var>       pending_decidable;// Variables made decidable during propagation, not yet in 'order_heap' nor notified to PCSolver.
     vec<Lit>            trail;            // Assignment stack; stores all assigments made in the order they were made.
     vec<int>            trail_lim;        // Separator indices for different decision levels in 'trail'.
     vec<VarData>        vardata;          // Stores reason and level for each variable.
     int                 qhead;            // Head of queue (as index into the trail -- no more explicit propagation queue in MiniSat).
+    /*AB*/
+    vec<int>            trail_heads;      // The queue heads of the other propagators when notifications are batched.
+    bool                batched_notify;   // Propagators fetch trail slices instead of being notified of every assignment (see 'setBatchedNotify()').
+    int                 batch_propagators;// The queue heads that 'batched_notify' waits for (0 = none).
+    double              ema_glue_fast;    // Exponential moving averages of the glue of learnt clauses, and of the trail size at conflicts.
+    double              ema_glue_slow;
+    double              ema_trail;
+    uint64_t            ema_count;        // Number of samples in the averages, to correct their initial bias.
+    /*AE*/
     int                 simpDB_assigns;   // Number of top-level assignments since last execution of 'simplify()'.
-    int64_t             simpDB_props;     // Remaining number of propagations that must be made before next execution of 'simplify()'.
+    /*A*/uint64_t       simpDB_ticks;     // The value of 'ticks' before which 'simplify()' does not run again.
     vec<Lit>            assumptions;      // Current set of assumptions provided to solve by the user.
-    Heap<VarOrderLt>    order_heap;       // A priority queue of variables ordered with respect to the variable activity.
+    /*AB*/
+    bool                packed;           // The assumptions of the last call to 'solve_()' are all on decision level 1 (see 'pack_assumps').
+    bool                searching;        // In 'solve_()'. Otherwise the clauses added above the root are kept in 'added_above_root'.
+    vec<CRef>           added_above_root; // Clauses added above the root since the last call, checked by 'reuseTrail()'.
+    /*AE*/
+    OrderHeap           order_heap;       // A priority queue of variables ordered with respect to the variable activity.
     double              progress_estimate;// Set by 'search()'.
     bool                remove_satisfied; // Indicates whether possibly inefficient linear scan for satisfied clauses should be performed in 'simplify'.
 
@@ -281,6 +477,28 @@ protected:
     vec<Lit>            analyze_stack;
     vec<Lit>            analyze_toclear;
     vec<Lit>            add_tmp;
+    /*AB*/
+    vec<CRef>           inprocess_queue;  // Problem clauses added since the last inprocessing round.
+    vec<vec<CRef> >     inproc_occ;       // Occurrences per variable, only filled for the variables of 'inprocess_queue'.
+    vec<vec<uint64_t> > inproc_sigs;      // The signatures of the clauses in 'inproc_occ'.
+    vec<char>           inproc_touched;
+    vec<Lit>            vivify_lits;
+    vec<char>           lookahead_phases; // 'polarity' before 'lookahead()', its probes are not phases to keep.
+    int                 vivify_next;      // Where the next round of vivification starts, in the core and then the mid tier.
+    uint64_t            next_inprocess;   // Number of conflicts before the next inprocessing round.
+    uint64_t            inprocess_props;  // Number of propagations at the end of the last inprocessing round.
+    /*AE*/
+    /*A*/vec<CRef>      strengthen_queue; // Reasons to strengthen after backtracking, found by 'analyze()'.
+    /*A*/vec<Lit>       cancel_kept;      // Literals kept by 'cancelUntil()' because they were assigned at a lower level than their position.
+    /*AB*/
+    vec<uint64_t>       lbd_seen;         // Per decision level, the value of 'lbd_counter' when it was last counted by 'computeLBD()'.
+    uint64_t            lbd_counter;
+    /*AE*/
+    /*AB*/
+    // Ids in 'stats' of the timers, counters and the histogram of the hot paths:
+    int                 st_propagate, st_notifypropagate, st_analyze, st_litredundant, st_reducedb, st_collect, st_simplify, st_inprocess, st_callbacks;
+    int                 st_watch_visits, st_blocker_hits, st_clause_derefs, st_glue;
+    /*AE*/
 
     double              max_learnts;
     double              learntsize_adjust_confl;
@@ -290,13 +508,42 @@ protected:
     //
     int64_t             conflict_budget;    // -1 means no budget.
     int64_t             propagation_budget; // -1 means no budget.
-    bool                asynch_interrupt;
+    /*AB*/
+    int64_t             tick_budget;        // -1 means no budget.
+    int64_t             deadline;           // Of 'std::chrono::steady_clock', in nanoseconds. -1 means no deadline.
+    mutable uint64_t    deadline_poll;      // The value of 'ticks' from which 'withinBudget()' reads the clock again.
+    /*AE*/
+    std::atomic<bool>   asynch_interrupt; // NOTE: set from another thread by a portfolio.
+    /*AB*/
+    ClauseExchange*     exchange;
+    int                 exchange_id;
+    vec<Lit>            import_tmp;
+    GaussPropagator*    gauss_prop;       // Created by 'finishParsing()' if 'gauss' is set and XOR constraints were found.
+    int                 export_clauses;   // Prefix of 'clauses' printed by 'printECNF()' (kept up to date when 'clauses' is compacted).
+    int                 export_roots;     // Prefix of the root level trail printed by 'printECNF()'.
+    /*AE*/
 
     /*AB*/
-	bool 				savedok;
-	int					savedlevel, savedclausessize, savedqhead;
-	vec<int>			savedtraillim;
-	vec<Lit>			savedtrail;
+    // Checkpoints only record what is needed to undo the changes made after them. Clauses are tagged
+    // with the epoch in which they were added, learnt clauses with the latest epoch of their
+    // antecedents, so learnt clauses that do not depend on later clauses survive a rollback.
+    struct Checkpoint {
+        uint32_t  epoch;            // Clauses with an epoch of at least this value were added (or derived) after the checkpoint.
+        bool      ok;
+        bool      remove_satisfied;
+        int       level;
+        int       trail_size;
+        int       qhead;
+        int       clauses_size;
+        int       intact_level;     // The decision levels below this one were never undone since the checkpoint.
+        int       intact_trail;     // Idem for the trail prefix up to this index.
+        vec<Lit>  decisions;        // Decisions of the undone levels 'intact_level'..'level'-1 (only filled when undone).
+        vec<Lit>  rootunits;        // Copy of 'rootunitlits' and the root literals that were above the root.
+    };
+    vec<Checkpoint>     checkpoints;
+    uint32_t            epoch;            // Epoch of clauses added now, incremented for every new checkpoint.
+    vec<uint32_t>       root_epoch;       // Epoch in which a root level literal was assigned.
+    uint32_t            analyze_epoch;    // Set by 'analyze()': the latest epoch of the antecedents of the learnt clause.
     /*AE*/
 
     // Main internal methods:
@@ -308,14 +555,43 @@ protected:
     bool     enqueue          (Lit p, CRef from = CRef_Undef);                         // Test if fact 'p' contradicts current state, enqueue otherwise.
     CRef     propagate        ();                                                      // Perform unit propagation. Returns possibly conflicting clause.
     /*AB*///void     cancelUntil      (int level);                                             // Backtrack until a certain level./*AE*/
-    void     analyze          (CRef confl, vec<Lit>& out_learnt, int& out_btlevel);    // (bt = backtrack)
+    void     analyze          (CRef confl, vec<Lit>& out_learnt, int& out_btlevel, int& out_glue);    // (bt = backtrack)
+    /*AB*/
+    void     recordLearnt     (vec<Lit>& learnt_clause, int glue);                     // Add the clause produced by 'analyze()' and enqueue its asserting literal.
+    void     recordProgress   ();                                                      // Add a row to the time series of 'stats'.
+    template<class Lits>
+    int      computeLBD       (const Lits& lits);                                      // Number of distinct non-root decision levels in 'lits'.
+    void     updateGlue       (Clause& c);                                             // Recompute the glue of a learnt clause, possibly promoting it.
+    int      tierOf           (int glue) const;
+    vec<CRef>& learntsOf      (int tier);
+    void     retier           (vec<CRef>& cs, int tier);                               // Move clauses of 'cs' that are not of 'tier' to their own list.
+    /*AE*/
     void     analyzeFinal     (Lit p, vec<Lit>& out_conflict);                         // COULD THIS BE IMPLEMENTED BY THE ORDINARIY "analyze" BY SOME REASONABLE GENERALIZATION?
     bool     litRedundant     (Lit p, uint32_t abstract_levels);                       // (helper method for 'analyze()')
+    /*AB*/
+    void     minimizeBinary   (vec<Lit>& out_learnt);                                  // (helper method for 'analyze()')
+    void     strengthenAntecedents();                                                  // Apply the on-the-fly subsumptions found by the last 'analyze()'.
+    /*AE*/
     lbool    search           (int nof_conflicts/*AB*/, bool nosearch/*AE*/);                                     // Search for a given number of conflicts.
     lbool    solve_           (/*AB*/bool nosearch = false/*AE*/);                                     // Main solve method(assumptions given in 'assumptions').
+    /*A*/lbool lookahead_     (const vec<Lit>& cube, int max_vars, Lit& best);         // (see 'lookahead()', which restores the phases)
     void     reduceDB         ();                                                      // Reduce the set of learnt clauses.
+    /*AB*/
+    void     checkMemory      ();                                                      // Lower the limit of learnt clauses if over 'mem_budget'.
+    void     measureMemory    ();                                                      // Update 'arena_bytes' and 'watch_bytes'.
+    void     openDratFile     ();                                                      // Open the proof of 'drat_file', once.
+    double   memoryPressure   () const;                                                // The fraction of 'mem_budget' in use (0 without a budget).
+    /*AE*/
     void     removeSatisfied  (vec<CRef>& cs);                                         // Shrink 'cs' to contain only non-satisfied clauses.
     void     rebuildOrderHeap ();
+    /*AB*/
+    bool     inprocess        ();                                                      // Simplify the clause database during search (at the root level).
+    void     subsumeQueued    (int64_t& work, int64_t budget);
+    bool     strengthenRoot   (CRef cr, Lit p);                                        // Remove 'p' from a clause at the root level.
+    void     vivifyLearnts    (int64_t& work, int64_t budget);
+    bool     vivify           (CRef cr);
+    void     purgeRemoved     (vec<CRef>& cs);                                         // Drop the removed clauses from 'cs'.
+    /*AE*/
 
     // Maintaining Variable/Clause activity:
     //
@@ -328,21 +604,65 @@ protected:
     // Operations on clauses:
     //
     void     attachClause     (CRef cr);               // Attach a clause to watcher lists.
+    /*A*/void     attachClauses    (const vec<CRef>& cs, int first); // Attach 'cs[first..]' (at the root level), growing each watcher list only once.
     void     detachClause     (CRef cr, bool strict = false); // Detach a clause to watcher lists.
     bool     locked           (const Clause& c) const; // Returns TRUE if a clause is a reason for some implication in the current state.
+    /*A*/bool     lockedBy         (const Clause& c, Lit p) const; // Returns TRUE if a clause is the reason for the true literal 'p'.
     bool     satisfied        (const Clause& c) const; // Returns TRUE if a clause is satisfied in the current state.
 
-    void     relocAll         (ClauseAllocator& to);
+    void     relocAll         (ClauseAllocator& to/*A*/, bool learnts_only = false);
 
     // Misc:
     //
     ///*A*/int      decisionLevel    ()      const; // Gives the current decisionlevel.
     uint32_t abstractLevel    (Var x) const; // Used to represent an abstraction of sets of decision levels.
     int      level            (Var x) const;
+    /*AB*/
+    Lit      binaryReason     (Var x) const; // The false literal of the binary reason for 'x', or lit_Undef if the reason is not binary.
+    void     reasonLits       (Var x, const Lit*& lits, int& nlits) const; // The literals of the reason for 'x', except 'x' itself.
+    /*AE*/
     double   progressEstimate ()      const; // DELETE THIS ?? IT'S NOT VERY USEFUL ...
     bool     withinBudget     ()      const;
+    /*A*/bool     beforeDeadline   ()      const; // Reads the clock, and sets when to do so again.
+    /*AB*/
+    void     recordUndoneLevels(int level);                 // Called when backtracking to 'level', updates the open checkpoints.
+    void     renumberEpochs   ();                          // Compact the epochs when the counter would overflow the clause header.
+    void     dependsOn        (const Clause& c) { if (c.epoch() > analyze_epoch) analyze_epoch = c.epoch(); }
+    void     dependsOnRoot    (Var x)           { if (root_epoch[x] > analyze_epoch) analyze_epoch = root_epoch[x]; }
+    /*AE*/
 
-    void 	checkDecisionVars(const Clause& c);
+    /*AB*/
+    void     checkDecisionVars  (const Clause& c);   // Make sure a non-false watch of 'c' is decidable (cheap if both watches are).
+    void     checkDecisionVars_ (const Clause& c);
+    void     makeDecidable      (Var v);             // Deferred version of 'setDecidable(v, true)', for use during propagation.
+    void     flushDecidable     ();                  // Insert the pending decidable variables in 'order_heap' and notify PCSolver.
+    void     clampTrailHeads    ();                  // Move the queue heads of the propagators back after the trail shrunk.
+    void     exportLearnt       (const vec<Lit>& learnt_clause, int glue);
+    void     importShared       ();                  // Add the clauses exported by the other solvers, at decision level 0.
+    void     noteUsedImport     (Clause& c)         { if (c.imported()) { c.imported(false); shared_useful++; } }
+    void     updateRestartAverages(int glue);        // Called for every conflict.
+    bool     glueRestartDue     (int conflictC) const;
+    bool     glueRestarts       () const { return glue_restart && not stable; } // (stable mode restarts on the Luby sequence)
+    bool     targetPhases       () const { return target_mode == 2 || (target_mode == 1 && stable); }
+    bool     rephasing          () const { return stable_mode > 0 && rephase_int > 0; }
+    void     saveTrailPhases    (int confl_level);   // Called for every conflict: the prefix of the trail below 'confl_level' as target and best phase, if larger.
+    bool     modeSwitchDue      () const;
+    void     switchMode         ();
+    void     rephase            ();                  // Reset 'polarity' to the original, inverted or best phase, or to the result of 'walk()'.
+    int      walk               ();                  // Random walk from 'polarity' over the problem clauses, keeps the best assignment in 'polarity'. Returns its number of false clauses.
+    int      restartLevel       ();                  // The level to backtrack to on a restart, reusing part of the trail if 'partial_restart'.
+    int      assumptionLevels   () const { return packed ? (assumptions.size() > 0 ? 1 : 0) : assumptions.size(); }
+    int      keptAssumptionLevels();                 // The decision levels of the trail that 'search()' would make again for 'assumptions'.
+    bool     reuseTrail         ();                  // Backtrack to these levels instead of the root, see there. False if the problem is unsatisfiable.
+    bool     decidePackedAssumptions();              // Decide all assumptions on the current level. False, with 'conflict' set, if one of them is false.
+    void     enqueueUnit        (CRef cr);           // Enqueue 'c[0]' of the unit clause 'cr' at the level of 'c[1]', its false literal of the highest level.
+    int      conflictLevel      (CRef confl) const;  // The highest level of the literals of 'confl' (0 if the root is inconsistent).
+    int      conflictBacktrackLevel(int backtrack_level, int learnt_size); // The level to backtrack to after a conflict (chronological or 'backtrack_level').
+    bool     hasCandidates      ();                  // False if there certainly is no unassigned decision variable left.
+    double   varScore           (Var v) const { return heuristic == heur_vmtf ? vmtf.score(v) : activity[v]; }
+    void     chbReward          (Var v);             // Update the CHB score of a variable that gets unassigned.
+    void     permuteRandomly    (vec<Lit>& lits);    // Shuffle 'lits' in place, with 'random_seed'.
+    /*AE*/
 
     // Static helpers:
     //
@@ -365,18 +685,67 @@ protected:
 
 inline CRef Solver::reason(Var x) const { return vardata[x].reason; }
 inline int  Solver::level (Var x) const { return vardata[x].level; }
+/*AB*/
+inline Lit  Solver::binaryReason(Var x) const { return vardata[x].binother; }
+inline void Solver::reasonLits(Var x, const Lit*& lits, int& nlits) const {
+    assert(reason(x) != CRef_Undef);
+    if (vardata[x].binother != lit_Undef){
+        lits  = &vardata[x].binother;
+        nlits = 1;
+    }else{
+        const Clause& c = ca[reason(x)];
+        lits  = (const Lit*)c + 1;
+        nlits = c.size() - 1; } }
+/*AE*/
+
+/*AB*/
+inline int Solver::trailSlice(int head, const Lit*& lits) {
+    int& h = trail_heads[head];
+    lits = (const Lit*)trail + h;
+    int n = trail.size() - h;
+    h = trail.size();
+    return n; }
+inline void Solver::clampTrailHeads() {
+    for (int i = 0; i < trail_heads.size(); i++)
+        if (trail_heads[i] > trail.size()) trail_heads[i] = trail.size(); }
+/*AE*/
 
 inline void Solver::insertVarOrder(Var x) {
+    /*A*/if (heuristic == heur_vmtf) { if (decision[x]) vmtf.update(x); return; }
     if (!order_heap.inHeap(x) && decision[x]) order_heap.insert(x); }
 
-inline void Solver::varDecayActivity() { var_inc *= (1 / var_decay); }
-inline void Solver::varBumpActivity(Var v) { varBumpActivity(v, var_inc); }
+/*AB*/
+inline void Solver::makeDecidable(Var v) {
+    if (lazy_decidable && !decision[v]){
+        decision[v] = 1;
+        dec_vars++;
+        pending_decidable.push(v); } }
+inline void Solver::checkDecisionVars(const Clause& c) {
+    if (lazy_decidable && !(decision[var(c[0])] && decision[var(c[1])]))
+        checkDecisionVars_(c); }
+/*AE*/
+
+/*AB*/
+inline void Solver::varDecayActivity() {
+    if (heuristic == heur_vsids) var_inc *= (1 / (stable ? stable_var_decay : var_decay));
+    else if (heuristic == heur_chb && chb_alpha > 0.06) chb_alpha -= 1e-6; }
+inline void Solver::varBumpActivity(Var v) {
+    switch (heuristic){
+    case heur_vmtf: vmtf.bump(v); if (value(v) == l_Undef) insertVarOrder(v); break;
+    case heur_chb:  chb_conflict[v] = conflicts; break;
+    default:        varBumpActivity(v, var_inc); } }
+inline void Solver::chbReward(Var v) {
+    double reward = 1.0 / (conflicts - chb_conflict[v] + 1);
+    activity[v] = (1 - chb_alpha) * activity[v] + chb_alpha * reward;
+    if (order_heap.inHeap(v)) order_heap.update(v); }
+/*AE*/
 inline void Solver::varBumpActivity(Var v, double inc) {
     if ( (activity[v] += inc) > 1e100 ) {
         // Rescale:
         for (int i = 0; i < nVars(); i++)
             activity[i] *= 1e-100;
-        var_inc *= 1e-100; }
+        var_inc *= 1e-100;
+        /*A*/order_heap.refresh(); }
 
     // Update order_heap with respect to new activity:
     if (order_heap.inHeap(v))
@@ -386,14 +755,60 @@ inline void Solver::claDecayActivity() { cla_inc *= (1 / clause_decay); }
 inline void Solver::claBumpActivity (Clause& c) {
         if ( (c.activity() += cla_inc) > 1e20 ) {
             // Rescale:
-            for (int i = 0; i < learnts.size(); i++)
-                ca[learnts[i]].activity() *= 1e-20;
+            /*AB*/
+            for (int i = 0; i < learnts_core.size(); i++)
+                ca[learnts_core[i]].activity() *= 1e-20;
+            for (int i = 0; i < learnts_mid.size(); i++)
+                ca[learnts_mid[i]].activity() *= 1e-20;
+            for (int i = 0; i < learnts_local.size(); i++)
+                ca[learnts_local[i]].activity() *= 1e-20;
+            /*AE*/
             cla_inc *= 1e-20; } }
 
+/*AB*/
+inline int Solver::tierOf(int glue) const { return glue <= core_lbd ? tier_core : glue <= mid_lbd ? tier_mid : tier_local; }
+inline vec<CRef>& Solver::learntsOf(int tier) { return tier == tier_core ? learnts_core : tier == tier_mid ? learnts_mid : learnts_local; }
+
+template<class Lits>
+inline int Solver::computeLBD(const Lits& lits) {
+    lbd_counter++;
+    int glue = 0;
+    for (int i = 0; i < lits.size(); i++){
+        int l = level(var(lits[i]));
+        if (l == 0) continue;
+        if (l >= lbd_seen.size()) lbd_seen.growTo(l + 1, 0);
+        if (lbd_seen[l] != lbd_counter){
+            lbd_seen[l] = lbd_counter;
+            glue++; } }
+    return glue; }
+
+// Glue is only updated lazily, when the clause shows up in conflict analysis. A lower glue can
+// promote the clause, the move to the list of its new tier is done by 'reduceDB()'.
+inline void Solver::updateGlue(Clause& c) {
+    assert(c.learnt());
+    c.used(true);
+    if ((int)c.glue() <= core_lbd) return;
+    int glue = computeLBD(c);
+    if (glue < (int)c.glue()){
+        c.glue(glue);
+        if (tierOf(glue) < (int)c.tier())
+            c.tier(tierOf(glue)); } }
+/*AE*/
+
+/*AB*/
+inline double Solver::memoryPressure() const {
+    return mem_budget == 0 ? 0 : (double)((uint64_t)ca.size() * ClauseAllocator::Unit_Size + watch_bytes) / (double)mem_budget; }
+/*AE*/
+
 inline void Solver::checkGarbage(void){ return checkGarbage(garbage_frac); }
 inline void Solver::checkGarbage(double gf){
-    if (ca.wasted() > ca.size() * gf)
-        garbageCollect(); }
+    /*AB*/
+    // The regions are collected by their own ratio: waste among the learnt clauses does not make the problem clauses move.
+    if (ca.wasted(false) > ca.size(false) * gf)
+        garbageCollect();
+    else if (ca.wasted(true) > ca.size(true) * gf)
+        collectLearnts(); }
+    /*AE*/
 
 // NOTE: enqueue does not set the ok flag! (only public methods do)
 inline bool     Solver::enqueue         (Lit p, CRef from)      { return value(p) != l_Undef ? value(p) != l_False : (uncheckedEnqueue(p, from), true); }
@@ -402,7 +817,8 @@ inline bool     Solver::addEmptyClause  ()                      { add_tmp.clear(
 inline bool     Solver::addClause       (Lit p)                 { add_tmp.clear(); add_tmp.push(p); return addClause_(add_tmp); }
 inline bool     Solver::addClause       (Lit p, Lit q)          { add_tmp.clear(); add_tmp.push(p); add_tmp.push(q); return addClause_(add_tmp); }
 inline bool     Solver::addClause       (Lit p, Lit q, Lit r)   { add_tmp.clear(); add_tmp.push(p); add_tmp.push(q); add_tmp.push(r); return addClause_(add_tmp); }
-inline bool     Solver::locked          (const Clause& c) const { return value(c[0]) == l_True && reason(var(c[0])) != CRef_Undef && ca.lea(reason(var(c[0]))) == &c; }
+inline bool     Solver::lockedBy        (const Clause& c, Lit p) const { return value(p) == l_True && reason(var(p)) != CRef_Undef && ca.lea(reason(var(p))) == &c; }
+inline bool     Solver::locked          (const Clause& c) const { return lockedBy(c, c[0]) || (c.size() == 2 && lockedBy(c, c[1])); } // NOTE: binary clauses can imply either literal.
 
 inline int      Solver::decisionLevel ()      const   { return trail_lim.size(); }
 inline uint32_t Solver::abstractLevel (Var x) const   { return 1 << (level(x) & 31); }
@@ -412,10 +828,11 @@ inline lbool    Solver::modelValue    (Var x) const   { return model[x]; }
 inline lbool    Solver::modelValue    (Lit p) const   { return model[var(p)] ^ sign(p); }
 inline int      Solver::nAssigns      ()      const   { return trail.size(); }
 inline int      Solver::nClauses      ()      const   { return clauses.size(); }
-inline int      Solver::nLearnts      ()      const   { return learnts.size(); }
+inline int      Solver::nLearnts      ()      const   { return learnts_core.size() + learnts_mid.size() + learnts_local.size(); }
 inline int      Solver::nVars         ()      const   { return vardata.size(); }
 inline int      Solver::nFreeVars     ()      const   { return (int)dec_vars - (trail_lim.size() == 0 ? trail.size() : trail_lim[0]); }
 inline void     Solver::setPolarity   (Var v, lbool b){ user_pol[v] = b; }
+/*A*/inline void Solver::setHeuristic  (int h)         { assert(nVars() == 0 && h >= heur_vsids && h <= heur_chb); heuristic = h; }
 /*inline void     Solver::setDecidable(Var v, bool decide) // NOTE: no-op if already a decision var!
 { 
 	if      ( decide && !decision[v]) dec_vars++;
@@ -426,13 +843,16 @@ inline void     Solver::setPolarity   (Var v, lbool b){ user_pol[v] = b; }
 }*/
 inline void     Solver::setConfBudget(int64_t x){ conflict_budget    = conflicts    + x; }
 inline void     Solver::setPropBudget(int64_t x){ propagation_budget = propagations + x; }
+/*A*/inline void Solver::setTickBudget(int64_t x){ tick_budget        = ticks        + x; }
 inline void     Solver::interrupt(){ asynch_interrupt = true; }
 inline void     Solver::clearInterrupt(){ asynch_interrupt = false; }
-inline void     Solver::budgetOff(){ conflict_budget = propagation_budget = -1; }
+inline void     Solver::budgetOff(){ conflict_budget = propagation_budget = /*A*/tick_budget = deadline = -1; }
 inline bool     Solver::withinBudget() const {
     return !asynch_interrupt &&
            (conflict_budget    < 0 || conflicts < (uint64_t)conflict_budget) &&
-           (propagation_budget < 0 || propagations < (uint64_t)propagation_budget); }
+           (propagation_budget < 0 || propagations < (uint64_t)propagation_budget) /*AB*/&&
+           (tick_budget        < 0 || ticks < (uint64_t)tick_budget) &&
+           (deadline           < 0 || ticks < deadline_poll || beforeDeadline())/*AE*/; }
 
 // FIXME: after the introduction of asynchronous interrruptions the solve-versions that return a
 // pure bool do not give a safe interface. Either interrupts must be possible to turn off here, or
@@ -43,11 +43,14 @@ typedef int Var;
 #define var_Undef (-1)
 
 
+struct Lit;
+Lit mkLit(Var var, bool sign = false);
+
 struct Lit {
     int     x;
 
     // Use this as a constructor:
-    friend Lit mkLit(Var var, bool sign = false);
+    friend Lit mkLit(Var var, bool sign);
 
     bool operator == (Lit p) const { return x == p.x; }
     bool operator != (Lit p) const { return x != p.x; }
@@ -123,7 +126,16 @@ const lbool l_Undef = toLbool((uint8_t)2);
 // Clause -- a simple class for representing a clause:
 
 class Clause;
-typedef RegionAllocator<uint32_t>::Ref CRef;
+/*AB*/
+// The clause arena is one block with 32 bit references by default; building with
+// 'MINISAT_SEGMENTED_ARENA' gives a segmented arena with 64 bit references (see 'SegmentedAllocator').
+#ifdef MINISAT_SEGMENTED_ARENA
+typedef SegmentedAllocator<uint32_t> ArenaAllocator;
+#else
+typedef RegionAllocator<uint32_t> ArenaAllocator;
+#endif
+typedef ArenaAllocator::Ref CRef;
+/*AE*/
 
 class Clause {
     struct {
@@ -131,8 +143,16 @@ class Clause {
         unsigned learnt    : 1;
         unsigned has_extra : 1;
         unsigned reloced   : 1;
-        unsigned size      : 27; }                        header;
-    union { Lit lit; float act; uint32_t abs; CRef rel; } data[1];
+        unsigned size      : 27;
+        /*AB*/
+        // NOTE: the first header word has no spare bits left, so glue information lives in a second one.
+        unsigned glue      : 8;     // Literal block distance (saturated), only meaningful for learnt clauses.
+        unsigned tier      : 2;     // Learnt clause database tier the clause belongs to.
+        unsigned used      : 1;     // Set when the clause took part in conflict analysis.
+        unsigned imported  : 1;     // Learnt by another solver of a portfolio and not yet used in conflict analysis.
+        unsigned epoch     : 20;    // Checkpoint epoch of the clause (learnt: the latest epoch of its antecedents).
+        /*AE*/ }                                          header;
+    union { Lit lit; float act; uint32_t abs; /*A*/uint32_t rel, pos; } data[1];
 
     friend class ClauseAllocator;
 
@@ -143,6 +163,13 @@ class Clause {
         header.has_extra = use_extra;
         header.reloced   = 0;
         header.size      = ps.size();
+        /*AB*/
+        header.glue      = ps.size() > Glue_Max ? Glue_Max : ps.size();
+        header.tier      = 0;
+        header.used      = 0;
+        header.imported  = 0;
+        header.epoch     = 0;
+        /*AE*/
 
         for (int i = 0; i < ps.size(); i++) 
             data[i].lit = ps[i];
@@ -153,6 +180,7 @@ class Clause {
             else
                 calcAbstraction();
         }
+        /*A*/if (header.size >= Long_Size) searchPos() = 2;
     }
 
     // NOTE: This constructor cannot be used directly (doesn't allocate enough memory).
@@ -169,9 +197,13 @@ class Clause {
             else 
                 data[header.size].abs = from.data[header.size].abs;
         }
+        /*A*/if (header.size >= Long_Size) searchPos() = from.data[header.size + from.header.has_extra].pos;
     }
 
 public:
+    /*A*/enum { Glue_Max = (1 << 8) - 1, Epoch_Max = (1 << 20) - 1 };
+    /*A*/enum { Long_Size = 16 }; // Clauses at least this long have a 'searchPos()' (one more word, after the extra field).
+
     void calcAbstraction() {
         assert(header.has_extra);
         uint32_t abstraction = 0;
@@ -181,7 +213,7 @@ public:
 
 
     int          size        ()      const   { return header.size; }
-    void         shrink      (int i)         { assert(i <= size()); if (header.has_extra) data[header.size-i] = data[header.size]; header.size -= i; }
+    void         shrink      (int i)         { assert(i <= size()); if (header.has_extra) data[header.size-i] = data[header.size]; header.size -= i; /*A*/if (header.size >= Long_Size) searchPos() = 2; }
     void         pop         ()              { shrink(1); }
     bool         learnt      ()      const   { return header.learnt; }
     bool         has_extra   ()      const   { return header.has_extra; }
@@ -190,8 +222,31 @@ public:
     const Lit&   last        ()      const   { return data[header.size-1].lit; }
 
     bool         reloced     ()      const   { return header.reloced; }
+    /*AB*/
+#ifdef MINISAT_SEGMENTED_ARENA
+    // NOTE: a 64 bit reference takes the first two words, which every clause has (see 'ClauseAllocator').
+    CRef         relocation  ()      const   { return (CRef)data[0].rel | (CRef)data[1].rel << 32; }
+    void         relocate    (CRef c)        { header.reloced = 1; data[0].rel = (uint32_t)c; data[1].rel = (uint32_t)(c >> 32); }
+#else
     CRef         relocation  ()      const   { return data[0].rel; }
     void         relocate    (CRef c)        { header.reloced = 1; data[0].rel = c; }
+#endif
+    /*AE*/
+
+    /*AB*/
+    uint32_t     glue        ()      const   { return header.glue; }
+    void         glue        (uint32_t g)    { header.glue = g > Glue_Max ? (uint32_t)Glue_Max : g; }
+    uint32_t     tier        ()      const   { return header.tier; }
+    void         tier        (uint32_t t)    { header.tier = t; }
+    bool         used        ()      const   { return header.used; }
+    void         used        (bool u)        { header.used = u; }
+    bool         imported    ()      const   { return header.imported; }
+    void         imported    (bool i)        { header.imported = i; }
+    uint32_t     epoch       ()      const   { return header.epoch; }
+    void         epoch       (uint32_t e)    { assert(e <= Epoch_Max); header.epoch = e; }
+    // Where the last search for a replacement watch found one, the next one starts there (see 'Solver::notifypropagate()'):
+    uint32_t&    searchPos   ()              { assert(header.size >= Long_Size); return data[header.size + header.has_extra].pos; }
+    /*AE*/
 
     // NOTE: somewhat unsafe to change the clause in-place! Must manually call 'calcAbstraction' afterwards for
     //       subsumption operations to behave correctly.
@@ -210,32 +265,52 @@ public:
 //=================================================================================================
 // ClauseAllocator -- a simple class for allocating memory for clauses:
 
-const CRef CRef_Undef = RegionAllocator<uint32_t>::Ref_Undef;
+const CRef CRef_Undef = /*A*/ArenaAllocator::Ref_Undef;
 class ClauseAllocator
 {
-    RegionAllocator<uint32_t> ra;
+    /*AB*/
+    // Problem clauses and learnt clauses are allocated in separate regions, so the learnt clauses, which
+    // come and go all the time, can be compacted without copying the problem clauses (see
+    // 'Solver::collectLearnts()'). The top bit of a reference tells the region without dereferencing it.
+    ArenaAllocator ra;    // Problem clauses.
+    ArenaAllocator la;    // Learnt clauses.
+    /*AE*/
 
     static uint32_t clauseWord32Size(int size, bool has_extra){
-        return (sizeof(Clause) + (sizeof(Lit) * (size-1 + (int)has_extra))) / sizeof(uint32_t); }
+        /*AB*/
+        int words = size + (int)has_extra + (int)(size >= Clause::Long_Size);
+#ifdef MINISAT_SEGMENTED_ARENA
+        if (words < 2) words = 2; // (room for a 64 bit relocation reference)
+#endif
+        /*AE*/
+        return (sizeof(Clause) + (sizeof(Lit) * (words-1))) / sizeof(uint32_t); }
 
  public:
-    enum { Unit_Size = RegionAllocator<uint32_t>::Unit_Size };
+    enum { Unit_Size = /*A*/ArenaAllocator::Unit_Size };
+    /*AB*/
+    typedef ArenaAllocator::Size Size;
+    static const CRef Learnt_Ref = (CRef)1 << (sizeof(CRef) * 8 - 1);
+    static bool       learntRef(CRef r) { return (r & Learnt_Ref) != 0; }
+    /*AE*/
 
     bool extra_clause_field;
 
-    ClauseAllocator(uint32_t start_cap) : ra(start_cap), extra_clause_field(false){}
+    ClauseAllocator(/*A*/Size start_cap, Size learnt_cap = 1024*1024) : ra(start_cap), /*A*/la(learnt_cap), extra_clause_field(false){}
     ClauseAllocator() : extra_clause_field(false){}
 
     void moveTo(ClauseAllocator& to){
         to.extra_clause_field = extra_clause_field;
-        ra.moveTo(to.ra); }
+        ra.moveTo(to.ra);
+        /*A*/la.moveTo(to.la); }
+
+    /*A*/void moveProblemClausesTo(ClauseAllocator& to){ ra.moveTo(to.ra); } // (their references stay valid)
 
     CRef alloc(const vec<Lit>& ps, bool learnt = false)
     {
         assert(sizeof(Lit)      == sizeof(uint32_t));
         assert(sizeof(float)    == sizeof(uint32_t));
         bool use_extra = learnt | extra_clause_field;
-        CRef cid       = ra.alloc(clauseWord32Size(ps.size(), use_extra));
+        CRef cid       = /*A*/allocIn(learnt, clauseWord32Size(ps.size(), use_extra));
         new (lea(cid)) Clause(ps, use_extra, learnt);
 
         return cid;
@@ -244,24 +319,42 @@ class ClauseAllocator
     CRef alloc(const Clause& from)
     {
         bool use_extra = from.learnt() | extra_clause_field;
-        CRef cid       = ra.alloc(clauseWord32Size(from.size(), use_extra));
+        CRef cid       = /*A*/allocIn(from.learnt(), clauseWord32Size(from.size(), use_extra));
         new (lea(cid)) Clause(from, use_extra);
         return cid; }
 
-    uint32_t size      () const      { return ra.size(); }
-    uint32_t wasted    () const      { return ra.wasted(); }
+    /*AB*/
+    Size size      () const            { return ra.size() + la.size(); }
+    Size wasted    () const            { return ra.wasted() + la.wasted(); }
+    Size size      (bool learnt) const { return learnt ? la.size() : ra.size(); }
+    Size wasted    (bool learnt) const { return learnt ? la.wasted() : ra.wasted(); }
+    /*AE*/
+
+    /*AB*/
+    // Make room for 'nclauses' more problem clauses with 'nlits' literals in total (a hint, for a single region it is capped well below the 32 bit limit):
+    void capacity(uint64_t nclauses, uint64_t nlits) {
+        uint64_t words = ra.size() + nclauses * (clauseWord32Size(1, extra_clause_field) - 1) + nlits;
+#ifndef MINISAT_SEGMENTED_ARENA
+        if (words > UINT32_MAX / 2) words = UINT32_MAX / 2;
+#endif
+        ra.capacity((Size)words); }
+
+    // Raw arena of one region, see 'RegionAllocator::data()':
+    const uint32_t* data    (bool learnt, Size from, Size& n) const { return (learnt ? la : ra).data(from, n); }
+    void            copyFrom(bool learnt, const uint32_t* from, Size size, Size wasted) { (learnt ? la : ra).copyFrom(from, size, wasted); }
+    /*AE*/
 
     // Deref, Load Effective Address (LEA), Inverse of LEA (AEL):
-    Clause&       operator[](CRef r)         { return (Clause&)ra[r]; }
-    const Clause& operator[](CRef r) const   { return (Clause&)ra[r]; }
-    Clause*       lea       (CRef r)         { return (Clause*)ra.lea(r); }
-    const Clause* lea       (CRef r) const   { return (Clause*)ra.lea(r);; }
-    CRef          ael       (const Clause* t){ return ra.ael((uint32_t*)t); }
+    Clause&       operator[](CRef r)         { return (Clause&)/*A*/region(r)[r & ~Learnt_Ref]; }
+    const Clause& operator[](CRef r) const   { return (Clause&)/*A*/region(r)[r & ~Learnt_Ref]; }
+    Clause*       lea       (CRef r)         { return (Clause*)/*A*/region(r).lea(r & ~Learnt_Ref); }
+    const Clause* lea       (CRef r) const   { return (Clause*)/*A*/region(r).lea(r & ~Learnt_Ref); }
+    CRef          ael       (const Clause* t){ return /*A*/t->learnt() ? la.ael((uint32_t*)t) | Learnt_Ref : ra.ael((uint32_t*)t); }
 
     void free(CRef cid)
     {
         Clause& c = operator[](cid);
-        ra.free(clauseWord32Size(c.size(), c.has_extra()));
+        /*A*/region(cid).free(clauseWord32Size(c.size(), c.has_extra()));
     }
 
     void reloc(CRef& cr, ClauseAllocator& to)
@@ -273,6 +366,19 @@ class ClauseAllocator
         cr = to.alloc(c);
         c.relocate(cr);
     }
+
+    /*AB*/
+ private:
+    ArenaAllocator&       region(CRef r)       { return learntRef(r) ? la : ra; }
+    const ArenaAllocator& region(CRef r) const { return learntRef(r) ? la : ra; }
+
+    CRef allocIn(bool learnt, uint32_t words) {
+        ArenaAllocator& a   = learnt ? la : ra;
+        CRef            cid = a.alloc(words);
+        if (a.size() > Learnt_Ref) // (the top bit of a reference is not part of the offset)
+            throw OutOfMemoryException();
+        return learnt ? cid | Learnt_Ref : cid; }
+    /*AE*/
 };
 
 
@@ -291,12 +397,17 @@ class OccLists
     OccLists(const Deleted& d) : deleted(d) {}
     
     void  init      (const Idx& idx){ occs.growTo(toInt(idx)+1); dirty.growTo(toInt(idx)+1, 0); }
+    /*A*/void  capacity  (int n)         { occs.capacity(n); dirty.capacity(n); }
     // Vec&  operator[](const Idx& idx){ return occs[toInt(idx)]; }
     Vec&  operator[](const Idx& idx){ return occs[toInt(idx)]; }
     Vec&  lookup    (const Idx& idx){ if (dirty[toInt(idx)]) clean(idx); return occs[toInt(idx)]; }
 
     void  cleanAll  ();
     void  clean     (const Idx& idx);
+    /*AB*/
+    uint64_t bytes  () const;       // Memory held by the lists (their capacity, not their size).
+    void  trim      ();             // Give back the capacity of the lists that use less than half of it.
+    /*AE*/
     void  smudge    (const Idx& idx){
         if (dirty[toInt(idx)] == 0){
             dirty[toInt(idx)] = 1;
@@ -336,6 +447,27 @@ void OccLists<Idx,Vec,Deleted>::clean(const Idx& idx)
 }
 
 
+/*AB*/
+template<class Idx, class Vec, class Deleted>
+uint64_t OccLists<Idx,Vec,Deleted>::bytes() const
+{
+    uint64_t b = (uint64_t)occs.capacity() * sizeof(Vec) + dirty.capacity() + (uint64_t)dirties.capacity() * sizeof(Idx);
+    for (int i = 0; i < occs.size(); i++)
+        b += (uint64_t)occs[i].capacity() * sizeof(occs[i][0]);
+    return b;
+}
+
+
+template<class Idx, class Vec, class Deleted>
+void OccLists<Idx,Vec,Deleted>::trim()
+{
+    for (int i = 0; i < occs.size(); i++)
+        if (occs[i].capacity() > 2 * occs[i].size() + 4) // (growing alone never leaves that much room)
+            occs[i].fit();
+}
+/*AE*/
+
+
 //=================================================================================================
 // CMap -- a class for mapping clauses to values:
 
@@ -344,7 +476,7 @@ template<class T>
 class CMap
 {
     struct CRefHash {
-        uint32_t operator()(CRef cr) const { return (uint32_t)cr; } };
+        uint32_t operator()(CRef cr) const { return /*A*/(uint32_t)((uint64_t)cr ^ ((uint64_t)cr >> 32)); } };
 
     typedef Map<CRef, T, CRefHash> HashTable;
     HashTable map;
@@ -425,7 +557,7 @@ inline Lit Clause::subsumes(const Clause& other) const
 inline void Clause::strengthen(Lit p)
 {
     remove(*this, p);
-    calcAbstraction();
+    if (!learnt()) calcAbstraction();   // (the extra field of a learnt clause is its activity)
 }
 
 //=================================================================================================
@@ -21,6 +21,11 @@ OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWA
 #ifndef Minisat_Alloc_h
 #define Minisat_Alloc_h
 
+#include <string.h>
+#if !defined(_MSC_VER) && !defined(__MINGW32__)
+#include <sys/mman.h>
+#endif
+
 #include "minisat/mtl/XAlloc.h"
 #include "minisat/mtl/Vec.h"
 
@@ -37,11 +42,10 @@ class RegionAllocator
     uint32_t  cap;
     uint32_t  wasted_;
 
-    void capacity(uint32_t min_cap);
-
  public:
     // TODO: make this a class for better type-checking?
     typedef uint32_t Ref;
+    typedef uint32_t Size;
     enum { Ref_Undef = UINT32_MAX };
     enum { Unit_Size = sizeof(T) };
 
@@ -55,6 +59,16 @@ class RegionAllocator
 
     uint32_t size      () const      { return sz; }
     uint32_t wasted    () const      { return wasted_; }
+    void     capacity  (uint32_t min_cap);
+
+    // Raw contents of the region, to store it and to restore it (replacing everything in it). The
+    // contents from 'from' on are contiguous, so 'n' is always 'size() - from':
+    const T* data      (Ref from, Size& n) const { assert(from < sz); n = sz - from; return memory + from; }
+    void     copyFrom  (const T* from, uint32_t size, uint32_t wasted) {
+        capacity(size);
+        if (size > 0) memcpy(memory, from, sizeof(T)*size);
+        sz      = size;
+        wasted_ = wasted; }
 
     Ref      alloc     (int size); 
     void     free      (int size)    { wasted_ += size; }
@@ -125,6 +139,150 @@ RegionAllocator<T>::alloc(int size)
 }
 
 
+//=================================================================================================
+// Segmented memory allocator:
+//
+// The interface of 'RegionAllocator', for arenas beyond its 32 bit limit. References are 64 bit and
+// memory is mapped in segments of 'Seg_Size' units that never move, so growing never copies and never
+// needs room for a second copy. A reference is '(segment << Seg_Bits) | offset'. An allocation that
+// does not fit in the rest of the mapped segments starts a new mapping (the rest is counted as
+// wasted), which has as many consecutive segments as the allocation needs. Where the platform has
+// them, the mappings are backed by huge pages.
+
+template<class T>
+class SegmentedAllocator
+{
+ public:
+    typedef uint64_t Ref;
+    typedef uint64_t Size;
+    static const Ref Ref_Undef = UINT64_MAX;
+    enum { Unit_Size = sizeof(T) };
+    enum { Seg_Bits = 24, Seg_Size = 1 << Seg_Bits };
+
+ private:
+    struct Block { void* mem; size_t bytes; };
+
+    vec<T*>    segs;      // The start of each segment.
+    vec<Block> blocks;    // The mappings the segments are part of.
+    Size       sz;
+    Size       wasted_;
+
+    void     map       (int nsegs);
+    void     release   ();
+
+    // Not copyable:
+    SegmentedAllocator(const SegmentedAllocator&);
+    SegmentedAllocator& operator=(const SegmentedAllocator&);
+
+ public:
+    // NOTE: the capacity only reserves the table of segments, memory is mapped when it is allocated.
+    explicit SegmentedAllocator(Size start_cap = 1024*1024) : sz(0), wasted_(0){ capacity(start_cap); }
+    ~SegmentedAllocator() { release(); }
+
+    Size     size      () const      { return sz; }
+    Size     wasted    () const      { return wasted_; }
+    void     capacity  (Size min_cap){ segs.capacity((int)((min_cap + Seg_Size - 1) >> Seg_Bits)); }
+
+    // Raw contents, see 'RegionAllocator::data()'. They are returned a segment at a time, so 'n' is
+    // the number of units from 'from' to the end of its segment (or of the contents):
+    const T* data      (Ref from, Size& n) const {
+        assert(from < sz);
+        Size end = (from | (Seg_Size - 1)) + 1;
+        n = (end < sz ? end : sz) - from;
+        return &segs[from >> Seg_Bits][from & (Seg_Size - 1)]; }
+    void     copyFrom  (const T* from, Size size, Size wasted);
+
+    Ref      alloc     (int size);
+    void     free      (int size)    { wasted_ += size; }
+
+    // Deref, Load Effective Address (LEA), Inverse of LEA (AEL):
+    T&       operator[](Ref r)       { assert(r < sz); return segs[r >> Seg_Bits][r & (Seg_Size - 1)]; }
+    const T& operator[](Ref r) const { assert(r < sz); return segs[r >> Seg_Bits][r & (Seg_Size - 1)]; }
+
+    T*       lea       (Ref r)       { assert(r < sz); return &segs[r >> Seg_Bits][r & (Seg_Size - 1)]; }
+    const T* lea       (Ref r) const { assert(r < sz); return &segs[r >> Seg_Bits][r & (Seg_Size - 1)]; }
+    Ref      ael       (const T* t)  {
+        for (int i = 0; i < segs.size(); i++)
+            if (t >= segs[i] && t < segs[i] + Seg_Size)
+                return ((Ref)i << Seg_Bits) + (Ref)(t - segs[i]);
+        assert(false);
+        return Ref_Undef; }
+
+    void     moveTo(SegmentedAllocator& to) {
+        to.release();
+        segs.moveTo(to.segs);
+        blocks.moveTo(to.blocks);
+        to.sz      = sz;
+        to.wasted_ = wasted_;
+        sz = wasted_ = 0;
+    }
+};
+
+template<class T>
+void SegmentedAllocator<T>::map(int nsegs)
+{
+    size_t bytes = (size_t)nsegs * Seg_Size * sizeof(T);
+#if !defined(_MSC_VER) && !defined(__MINGW32__)
+    void* mem = mmap(NULL, bytes, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (mem == MAP_FAILED)
+        throw OutOfMemoryException();
+#ifdef MADV_HUGEPAGE
+    madvise(mem, bytes, MADV_HUGEPAGE);
+#endif
+#else
+    void* mem = xrealloc(NULL, bytes);
+#endif
+    Block b = { mem, bytes };
+    blocks.push(b);
+    for (int i = 0; i < nsegs; i++)
+        segs.push((T*)mem + (size_t)i * Seg_Size);
+}
+
+template<class T>
+void SegmentedAllocator<T>::release()
+{
+    for (int i = 0; i < blocks.size(); i++)
+#if !defined(_MSC_VER) && !defined(__MINGW32__)
+        munmap(blocks[i].mem, blocks[i].bytes);
+#else
+        ::free(blocks[i].mem);
+#endif
+    blocks.clear(true);
+    segs.clear(true);
+    sz = wasted_ = 0;
+}
+
+template<class T>
+typename SegmentedAllocator<T>::Ref
+SegmentedAllocator<T>::alloc(int size)
+{
+    assert(size > 0);
+    Size end = (Size)segs.size() << Seg_Bits;
+    if (sz + size > end){
+        wasted_ += end - sz;
+        sz       = end;
+        map((int)(((Size)size + Seg_Size - 1) >> Seg_Bits));
+    }
+
+    Ref prev_sz = sz;
+    sz += size;
+    return prev_sz;
+}
+
+// NOTE: the contents are copied into one mapping, so each reference of 'from' stays valid even if it
+// was laid out differently (e.g. by a 'RegionAllocator').
+template<class T>
+void SegmentedAllocator<T>::copyFrom(const T* from, Size size, Size wasted)
+{
+    release();
+    if (size > 0){
+        map((int)((size + Seg_Size - 1) >> Seg_Bits));
+        memcpy(segs[0], from, sizeof(T)*size);
+    }
+    sz      = size;
+    wasted_ = wasted;
+}
+
 //=================================================================================================
 }
 
@@ -136,6 +136,9 @@ class Heap {
             percolateDown(i);
     }
 
+    // Nothing to do, the keys are not copied (for compatibility with 'QuadHeap'):
+    void refresh() { }
+
     void clear(bool dealloc = false) 
     { 
         for (int i = 0; i < heap.size(); i++)
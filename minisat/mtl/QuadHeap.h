@@ -0,0 +1,201 @@
+/*************************************************************************************[QuadHeap.h]
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT
+NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT
+OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+**************************************************************************************************/
+
+#ifndef Minisat_QuadHeap_h
+#define Minisat_QuadHeap_h
+
+#include <stdint.h>
+#include <string.h>
+
+#include "minisat/mtl/Vec.h"
+#include "minisat/mtl/XAlloc.h"
+
+namespace Minisat {
+
+//=================================================================================================
+// A 4-ary heap with the same interface as 'Heap', but which stores a copy of the key of each element
+// next to it, so percolating does not need a load through the comparator per comparison. The four
+// children of a node are adjacent and (for keys of at most 12 bytes) share one 64 byte cache line.
+//
+// 'Comp' must provide:
+//   typedef ... Key;                           -- a trivially copyable type.
+//   Key  key   (int n)        const;           -- the current key of element 'n'.
+//   bool better(Key a, Key b) const;           -- true if 'a' must come before 'b'.
+//
+// The keys are read when an element is inserted, decreased, increased or updated. If the keys of
+// elements in the heap change without that (for example by rescaling), 'refresh()' must be called.
+
+template<class Comp>
+class QuadHeap {
+    typedef typename Comp::Key Key;
+    struct Entry { Key key; int n; };
+
+    enum { Offset = 3, Line = 64 };  // Element 'i' is stored at 'data[i + Offset]', so the children of a node start on a cache line.
+
+    Comp     lt;
+    Entry*   data;       // Aligned to 'Line'.
+    void*    mem;        // Allocated block containing 'data'.
+    int      sz;
+    int      cap;
+    vec<int> indices;    // Each element's position (index) in the heap
+
+    Entry&       at(int i)       { return data[i + Offset]; }
+    const Entry& at(int i) const { return data[i + Offset]; }
+
+    static inline int firstChild(int i) { return 4*i + 1; }
+    static inline int parent    (int i) { return (i-1) >> 2; }
+
+    void capacity(int min_cap) {
+        if (cap >= min_cap) return;
+        int   new_cap = cap;
+        while (new_cap < min_cap) new_cap = new_cap < 16 ? 16 : new_cap + (new_cap >> 1);
+        void* new_mem = xrealloc(NULL, (new_cap + Offset) * sizeof(Entry) + Line);
+        Entry* new_data = (Entry*)(((uintptr_t)new_mem + Line - 1) & ~(uintptr_t)(Line - 1));
+        if (sz > 0) memcpy(new_data + Offset, data + Offset, sz * sizeof(Entry));
+        free(mem);
+        mem  = new_mem;
+        data = new_data;
+        cap  = new_cap; }
+
+    void percolateUp(int i) {
+        Entry x = at(i);
+        while (i != 0){
+            int p = parent(i);
+            if (!lt.better(x.key, at(p).key)) break;
+            at(i)            = at(p);
+            indices[at(i).n] = i;
+            i                = p; }
+        at(i)      = x;
+        indices[x.n] = i; }
+
+    void percolateDown(int i) {
+        Entry x = at(i);
+        for (;;){
+            int c = firstChild(i);
+            if (c >= sz) break;
+            int end  = c + 4 < sz ? c + 4 : sz;
+            int best = c;
+            for (int k = c + 1; k < end; k++)
+                if (lt.better(at(k).key, at(best).key)) best = k;
+            if (!lt.better(at(best).key, x.key)) break;
+            at(i)            = at(best);
+            indices[at(i).n] = i;
+            i                = best; }
+        at(i)      = x;
+        indices[x.n] = i; }
+
+    // Not copyable:
+    QuadHeap(const QuadHeap&);
+    QuadHeap& operator=(const QuadHeap&);
+
+  public:
+    QuadHeap(const Comp& c) : lt(c), data(NULL), mem(NULL), sz(0), cap(0) { }
+   ~QuadHeap() { free(mem); }
+
+    int  size      ()          const { return sz; }
+    bool empty     ()          const { return sz == 0; }
+    bool inHeap    (int n)     const { return n < indices.size() && indices[n] >= 0; }
+    int  operator[](int index) const { assert(index < sz); return at(index).n; }
+
+
+    void decrease  (int n) { assert(inHeap(n)); at(indices[n]).key = lt.key(n); percolateUp  (indices[n]); }
+    void increase  (int n) { assert(inHeap(n)); at(indices[n]).key = lt.key(n); percolateDown(indices[n]); }
+
+
+    // Safe variant of insert/decrease/increase:
+    void update(int n)
+    {
+        if (!inHeap(n))
+            insert(n);
+        else {
+            at(indices[n]).key = lt.key(n);
+            percolateUp(indices[n]);
+            percolateDown(indices[n]); }
+    }
+
+
+    void insert(int n)
+    {
+        indices.growTo(n+1, -1);
+        assert(!inHeap(n));
+
+        capacity(sz + 1);
+        indices[n]   = sz;
+        at(sz).key   = lt.key(n);
+        at(sz).n     = n;
+        sz++;
+        percolateUp(indices[n]);
+    }
+
+    int peek(){
+    	return at(0).n;
+    }
+
+    int  removeMin()
+    {
+        int x            = at(0).n;
+        at(0)            = at(sz - 1);
+        indices[at(0).n] = 0;
+        indices[x]       = -1;
+        sz--;
+        if (sz > 1) percolateDown(0);
+        return x;
+    }
+
+
+    // Rebuild the heap from scratch, using the elements in 'ns':
+    void build(vec<int>& ns) {
+        for (int i = 0; i < sz; i++)
+            indices[at(i).n] = -1;
+        sz = 0;
+
+        capacity(ns.size());
+        for (int i = 0; i < ns.size(); i++){
+            indices.growTo(ns[i]+1, -1);
+            indices[ns[i]] = i;
+            at(i).key      = lt.key(ns[i]);
+            at(i).n        = ns[i]; }
+        sz = ns.size();
+
+        for (int i = parent(sz - 1); i >= 0; i--)
+            percolateDown(i);
+    }
+
+    // Read all keys again and restore the heap order:
+    void refresh() {
+        for (int i = 0; i < sz; i++)
+            at(i).key = lt.key(at(i).n);
+        for (int i = parent(sz - 1); i >= 0; i--)
+            percolateDown(i);
+    }
+
+    void clear(bool dealloc = false)
+    {
+        for (int i = 0; i < sz; i++)
+            indices[at(i).n] = -1;
+        sz = 0;
+        if (dealloc){
+            free(mem);
+            mem = NULL; data = NULL; cap = 0; }
+    }
+};
+
+
+//=================================================================================================
+}
+
+#endif
@@ -68,6 +68,7 @@ public:
     void     growTo   (int size);
     void     growTo   (int size, const T& pad);
     void     clear    (bool dealloc = false);
+    void     fit      (void);          // Give back the capacity beyond the size.
 
     // Stack interface:
     void     push  (void)              { if (sz == cap) capacity(sz+1); new (&data[sz]) T(); sz++; }
@@ -124,6 +125,14 @@ void vec<T>::clear(bool dealloc) {
         sz = 0;
         if (dealloc) free(data), data = NULL, cap = 0; } }
 
+
+template<class T>
+void vec<T>::fit(void) {
+    if (cap == sz) return;
+    if (sz == 0){ clear(true); return; }
+    T* smaller = (T*)::realloc(data, sz * sizeof(T));
+    if (smaller != NULL) data = smaller, cap = sz; } // (keeps the larger block if it cannot be shrunk)
+
 //=================================================================================================
 }
 
@@ -165,6 +165,8 @@ int main(int argc, char** argv)
                 printStats(S);
                 printf("\n"); }
             printf("UNSATISFIABLE\n");
+            if (S.stats_file != NULL) S.writeStats();
+            S.closeProof();
             exit(20);
         }
 
@@ -199,6 +201,7 @@ int main(int argc, char** argv)
         }
 
 #ifdef NDEBUG
+        S.closeProof();
         exit(ret == l_True ? 10 : ret == l_False ? 20 : 0);     // (faster than "return", which will invoke the destructor for 'Solver')
 #else
         return (ret == l_True ? 10 : ret == l_False ? 20 : 0);
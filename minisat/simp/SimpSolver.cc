@@ -65,6 +65,7 @@ SimpSolver::SimpSolver() :
     ca.extra_clause_field = true; // NOTE: must happen before allocating the dummy clause below.
     bwdsub_tmpunit        = ca.alloc(dummy);
     remove_satisfied      = false;
+    /*A*/st_eliminate         = stats.timer("eliminate");
 }
 
 
@@ -116,8 +117,11 @@ lbool SimpSolver::solve_(bool do_simp, bool turn_off_simp)
 
     if (result == l_True)
         result = Solver::solve_();
-    else if (verbosity >= 1)
-        printf("===============================================================================\n");
+    else{
+        if (verbosity >= 1)
+            printf("===============================================================================\n");
+        if (stats_file != NULL) writeStats(); // (done by 'Solver::solve_()' otherwise)
+    }
 
     if (result == l_True)
         extendModel();
@@ -197,6 +201,13 @@ bool SimpSolver::strengthenClause(CRef cr, Lit l)
     // if (!find(subsumption_queue, &c))
     subsumption_queue.insert(cr);
 
+    if (proof.isOpen()){ // (before the original can be deleted)
+        vec<Lit> strengthened;
+        for (int i = 0; i < c.size(); i++)
+            if (c[i] != l) strengthened.push(c[i]);
+        proof.add(strengthened);
+        if (c.size() > 2) proof.remove(c); }
+
     if (c.size() == 2){
         removeClause(cr);
         c.strengthen(l);
@@ -222,6 +233,7 @@ bool SimpSolver::merge(const Clause& _ps, const Clause& _qs, Var v, vec<Lit>& ou
     bool  ps_smallest = _ps.size() < _qs.size();
     const Clause& ps  =  ps_smallest ? _qs : _ps;
     const Clause& qs  =  ps_smallest ? _ps : _qs;
+    /*A*/ticks += ps.size() + qs.size();
 
     for (int i = 0; i < qs.size(); i++){
         if (var(qs[i]) != v){
@@ -252,6 +264,7 @@ bool SimpSolver::merge(const Clause& _ps, const Clause& _qs, Var v, int& size)
     bool  ps_smallest = _ps.size() < _qs.size();
     const Clause& ps  =  ps_smallest ? _qs : _ps;
     const Clause& qs  =  ps_smallest ? _ps : _qs;
+    /*A*/ticks += ps.size() + qs.size();
     const Lit*  __ps  = (const Lit*)ps;
     const Lit*  __qs  = (const Lit*)qs;
 
@@ -286,6 +299,7 @@ void SimpSolver::gatherTouchedClauses()
     for (i = 0; i < touched.size(); i++)
         if (touched[i]){
             const vec<CRef>& cs = occurs.lookup(i);
+            /*A*/ticks += cs.size();
             for (j = 0; j < cs.size(); j++)
                 if (ca[cs[j]].mark() == 0){
                     subsumption_queue.insert(cs[j]);
@@ -364,6 +378,7 @@ bool SimpSolver::backwardSubsumptionCheck(bool verbose)
         // Search all candidates:
         vec<CRef>& _cs = occurs.lookup(best);
         CRef*       cs = (CRef*)_cs;
+        /*A*/ticks += c.size() + _cs.size();
 
         for (int j = 0; j < _cs.size(); j++)
             if (c.mark())
@@ -425,6 +440,7 @@ bool SimpSolver::asymmVar(Var v)
 
     if (value(v) != l_Undef || cls.size() == 0)
         return true;
+    /*A*/ticks += cls.size(); // (the propagations count themselves)
 
     for (int i = 0; i < cls.size(); i++)
         if (!asymm(v, cls[i]))
@@ -477,6 +493,7 @@ bool SimpSolver::eliminateVar(Var v)
     //
     const vec<CRef>& cls = occurs.lookup(v);
     vec<CRef>        pos, neg;
+    /*A*/ticks += cls.size();
     for (int i = 0; i < cls.size(); i++)
         (find(ca[cls[i]], mkLit(v)) ? pos : neg).push(cls[i]);
 
@@ -507,11 +524,17 @@ bool SimpSolver::eliminateVar(Var v)
         mkElimClause(elimclauses, ~mkLit(v));
     }
 
+    // Produce clauses in cross product:
+    vec<Lit>& resolvent = add_tmp;
+    if (proof.isOpen()) // (the resolvents only follow while their antecedents are not deleted)
+        for (int i = 0; i < pos.size(); i++)
+            for (int j = 0; j < neg.size(); j++)
+                if (merge(ca[pos[i]], ca[neg[j]], v, resolvent))
+                    proof.add(resolvent);
+
     for (int i = 0; i < cls.size(); i++)
         removeClause(cls[i]); 
 
-    // Produce clauses in cross product:
-    vec<Lit>& resolvent = add_tmp;
     for (int i = 0; i < pos.size(); i++)
         for (int j = 0; j < neg.size(); j++)
             if (merge(ca[pos[i]], ca[neg[j]], v, resolvent) && !addClause_(resolvent))
@@ -523,6 +546,8 @@ bool SimpSolver::eliminateVar(Var v)
     // Free watchers lists for this variable, if possible:
     if (watches[ mkLit(v)].size() == 0) watches[ mkLit(v)].clear(true);
     if (watches[~mkLit(v)].size() == 0) watches[~mkLit(v)].clear(true);
+    if (binwatches[ mkLit(v)].size() == 0) binwatches[ mkLit(v)].clear(true);
+    if (binwatches[~mkLit(v)].size() == 0) binwatches[~mkLit(v)].clear(true);
 
     return backwardSubsumptionCheck();
 }
@@ -549,6 +574,7 @@ bool SimpSolver::substitute(Var v, Lit x)
             Lit p = c[j];
             subst_clause.push(var(p) == v ? x ^ sign(p) : p);
         }
+        if (proof.isOpen()) proof.add(subst_clause);
 
         removeClause(cls[i]);
 
@@ -579,6 +605,7 @@ void SimpSolver::extendModel()
 
 bool SimpSolver::eliminate(bool turn_off_elim)
 {
+    /*A*/StatTimer timer(stats, st_eliminate);
     if (!simplify())
         return false;
     else if (!use_simplification)
@@ -108,6 +108,12 @@ class SimpSolver : public Solver {
         // 32-bit implementation instead then, but this will have to do for now.
         uint64_t cost  (Var x)        const { return (uint64_t)n_occ[toInt(mkLit(x))] * (uint64_t)n_occ[toInt(~mkLit(x))]; }
         bool operator()(Var x, Var y) const { return cost(x) < cost(y); }
+
+        /*AB*/
+        typedef uint64_t Key; // For 'QuadHeap'
+        Key  key       (Var x)        const { return cost(x); }
+        bool better    (Key a, Key b) const { return a < b; }
+        /*AE*/
         
         // TODO: investigate this order alternative more.
         // bool operator()(Var x, Var y) const { 
@@ -125,12 +131,17 @@ class SimpSolver : public Solver {
     //
     int                 elimorder;
     bool                use_simplification;
+    /*A*/int            st_eliminate;     // Timer in 'stats'.
     vec<uint32_t>       elimclauses;
     vec<char>           touched;
     OccLists<Var, vec<CRef>, ClauseDeleted>
                         occurs;
     vec<int>            n_occ;
+#ifdef MINISAT_QUAD_HEAP
+    QuadHeap<ElimLt>    elim_heap;
+#else
     Heap<ElimLt>        elim_heap;
+#endif
     Queue<CRef>         subsumption_queue;
     vec<char>           frozen;
     vec<char>           eliminated;
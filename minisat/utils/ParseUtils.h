@@ -23,9 +23,25 @@ OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWA
 
 #include <stdlib.h>
 #include <stdio.h>
+#include <string.h>
+/*AB*/
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+#if !defined(_MSC_VER) && !defined(__MINGW32__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+/*AE*/
 
 #include <zlib.h>
 
+#include "minisat/mtl/IntTypes.h"
+#include "minisat/mtl/XAlloc.h"
+
 namespace Minisat {
 
 //-------------------------------------------------------------------------------------------------
@@ -54,11 +70,121 @@ public:
 };
 
 
+/*AB*/
+//-------------------------------------------------------------------------------------------------
+// A character stream like 'StreamBuffer', but decompressing in a separate thread:
+//
+// The reading thread fills a ring of buffers ahead of the parser, so 'gzread' overlaps parsing.
+
+class ThreadedStreamBuffer {
+    enum { Buffers = 4 };
+
+    gzFile                  in;
+    unsigned char*          bufs [Buffers];
+    int                     sizes[Buffers];
+    int                     filled;    // Number of buffers read so far.
+    int                     consumed;  // Number of buffers released by the parser.
+    bool                    stop;
+    std::mutex              mtx;
+    std::condition_variable cv;
+    std::thread             reader;
+
+    const unsigned char*    buf;       // The buffer the parser is in, number 'cur'.
+    int                     cur;
+    int                     pos;
+    int                     size;
+
+    void read() {
+        for (int i = 0;; i++){
+            {
+                std::unique_lock<std::mutex> lock(mtx);
+                cv.wait(lock, [&]{ return stop || i - consumed < Buffers; });
+                if (stop) return;
+            }
+            int n = gzread(in, bufs[i % Buffers], buffer_size);
+            {
+                std::lock_guard<std::mutex> lock(mtx);
+                sizes[i % Buffers] = n < 0 ? 0 : n;
+                filled = i + 1;
+            }
+            cv.notify_all();
+            if (n <= 0) return; } }
+
+    void assureLookahead() {
+        if (pos < size || (cur >= 0 && size == 0)) return;
+        std::unique_lock<std::mutex> lock(mtx);
+        consumed = cur + 1;
+        cur++;
+        cv.notify_all();
+        cv.wait(lock, [&]{ return filled > cur; });
+        buf  = bufs [cur % Buffers];
+        size = sizes[cur % Buffers];
+        pos  = 0; }
+
+public:
+    explicit ThreadedStreamBuffer(gzFile i) : in(i), filled(0), consumed(0), stop(false), buf(NULL), cur(-1), pos(0), size(0) {
+        for (int b = 0; b < Buffers; b++)
+            bufs[b] = (unsigned char*)xrealloc(NULL, buffer_size);
+        reader = std::thread(&ThreadedStreamBuffer::read, this);
+        assureLookahead(); }
+
+    ~ThreadedStreamBuffer() {
+        {
+            std::lock_guard<std::mutex> lock(mtx);
+            stop = true;
+        }
+        cv.notify_all();
+        reader.join();
+        for (int b = 0; b < Buffers; b++)
+            free(bufs[b]); }
+
+    int  operator *  () const { return (pos >= size) ? EOF : buf[pos]; }
+    void operator ++ ()       { pos++; assureLookahead(); }
+    int  position    () const { return pos; }
+};
+
+
+//-------------------------------------------------------------------------------------------------
+// A read-only memory mapping of a whole file ('data' is NULL if the file could not be mapped):
+
+class MappedFile {
+    MappedFile(const MappedFile&);
+    MappedFile& operator=(const MappedFile&);
+
+public:
+    const char* data;
+    uint64_t    size;
+
+    explicit MappedFile(const char* path) : data(NULL), size(0) {
+#if !defined(_MSC_VER) && !defined(__MINGW32__)
+        int fd = open(path, O_RDONLY);
+        if (fd < 0) return;
+        struct stat st;
+        if (fstat(fd, &st) == 0 && S_ISREG(st.st_mode) && st.st_size > 0){
+            void* m = mmap(NULL, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (m != MAP_FAILED){
+                madvise(m, st.st_size, MADV_SEQUENTIAL);
+                data = (const char*)m;
+                size = st.st_size; } }
+        close(fd);
+#endif
+    }
+
+    ~MappedFile() {
+#if !defined(_MSC_VER) && !defined(__MINGW32__)
+        if (data != NULL) munmap((void*)data, size);
+#endif
+    }
+};
+/*AE*/
+
+
 //-------------------------------------------------------------------------------------------------
 // End-of-file detection functions for StreamBuffer and char*:
 
 
 static inline bool isEof(StreamBuffer& in) { return *in == EOF;  }
+/*A*/static inline bool isEof(ThreadedStreamBuffer& in) { return *in == EOF;  }
 static inline bool isEof(const char*   in) { return *in == '\0'; }
 
 //-------------------------------------------------------------------------------------------------
@@ -93,6 +219,57 @@ static int parseInt(B& in) {
     return neg ? -val : val; }
 
 
+/*AB*/
+// Like 'parseInt()', but returns false (at the offending character) instead of exiting if there is no
+// number or it does not fit in an 'int'.
+template<class B>
+static bool tryParseInt(B& in, int& val) {
+    int64_t v   = 0;
+    bool    neg = false;
+    skipWhitespace(in);
+    if      (*in == '-') neg = true, ++in;
+    else if (*in == '+') ++in;
+    if (*in < '0' || *in > '9') return false;
+    while (*in >= '0' && *in <= '9'){
+        v = v*10 + (*in - '0'),
+        ++in;
+        if (v > INT32_MAX) return false; }
+    val = (int)(neg ? -v : v);
+    return true; }
+
+
+// Parses the unsigned decimal number at 'p' (not reading at or beyond 'end') into 'val', and returns
+// the position after it. Returns 'p' if there is no number or it does not fit in 31 bits. Eight
+// characters at a time are tested for digits and converted with a few multiplications.
+static inline const char* scanUnsigned(const char* p, const char* end, uint32_t& val) {
+    const char* start = p;
+    uint64_t    v     = 0;
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+    static const uint64_t pow10[9] = { 1, 10, 100, 1000, 10000, 100000, 1000000, 10000000, 100000000 };
+    while (end - p >= 8){
+        uint64_t w;
+        memcpy(&w, p, 8);
+        // A byte is a digit iff 'b - '0'' is below 10; borrows and carries only spoil the bytes after a non-digit:
+        uint64_t t        = w - 0x3030303030303030ULL;
+        uint64_t nondigit = (t | (t + 0x7676767676767676ULL)) & 0x8080808080808080ULL;
+        int      len      = nondigit ? __builtin_ctzll(nondigit) >> 3 : 8;
+        if (len == 0) break;
+        t <<= 8 * (8 - len);  // (as if padded with leading zeros to 8 digits)
+        t   = (t * 10) + (t >> 8);
+        t   = (uint32_t)((((t & 0x000000FF000000FFULL) * 0x000F424000000064ULL) + (((t >> 16) & 0x000000FF000000FFULL) * 0x0000271000000001ULL)) >> 32);
+        v   = v * pow10[len] + t;
+        p  += len;
+        if (v > INT32_MAX) return start;
+        if (len < 8) { val = (uint32_t)v; return p; } }
+#endif
+    for (; p < end && *p >= '0' && *p <= '9'; p++){
+        v = v*10 + (*p - '0');
+        if (v > INT32_MAX) return start; }
+    val = (uint32_t)v;
+    return p; }
+/*AE*/
+
+
 // String matching: in case of a match the input iterator will be advanced the corresponding
 // number of characters.
 template<class B>
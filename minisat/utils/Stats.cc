@@ -0,0 +1,112 @@
+/**************************************************************************************[Stats.cc]
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT
+NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT
+OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+**************************************************************************************************/
+
+#include <stdio.h>
+#include <string.h>
+
+#include "minisat/utils/Stats.h"
+#include "minisat/utils/System.h"
+
+using namespace Minisat;
+
+static void putDouble(WriteBuffer& out, double d) {
+    if (d == (double)(int64_t)d && d > -1e15 && d < 1e15){ // (counts in the time series stay exact)
+        out.putInt((int64_t)d);
+        return; }
+    char tmp[32];
+    snprintf(tmp, sizeof(tmp), "%.6g", d);
+    out.put(tmp); }
+
+static void putName(WriteBuffer& out, const char* name) {
+    out.put('"'); out.put(name); out.put("\": "); }
+
+double StatsRegistry::timerSeconds(int t) const
+{
+#if defined(__x86_64__) || defined(__i386__)
+    // The rate of the time stamp counter, measured over the lifetime of the registry:
+    double elapsed = seconds();
+    if (elapsed <= 0) return 0;
+    return timers[t].ticks * elapsed / (double)(statTicks() - start_ticks);
+#else
+    return timers[t].ticks / 1e9;
+#endif
+}
+
+// NOTE: the names are not escaped, they are meant to be identifiers.
+void StatsRegistry::writeJSON(WriteBuffer& out) const
+{
+    out.put("{\n  ");
+    putName(out, "seconds");         putDouble(out, seconds());     out.put(",\n  ");
+    putName(out, "cpu_seconds");     putDouble(out, cpuTime());     out.put(",\n  ");
+    putName(out, "memory_mb");       putDouble(out, memUsed());     out.put(",\n  ");
+    putName(out, "memory_peak_mb");  putDouble(out, memUsedPeak()); out.put(",\n  ");
+
+    putName(out, "counters"); out.put('{');
+    for (int i = 0; i < counters.size(); i++){
+        out.put(i == 0 ? "\n    " : ",\n    ");
+        putName(out, counters[i].name); out.putInt(value(i)); }
+    out.put("\n  },\n  ");
+
+    putName(out, "timers"); out.put('{');
+    for (int i = 0; i < timers.size(); i++){
+        out.put(i == 0 ? "\n    " : ",\n    ");
+        putName(out, timers[i].name);
+        out.put("{ \"seconds\": "); putDouble(out, timerSeconds(i));
+        out.put(", \"calls\": ");   out.putInt(timers[i].calls); out.put(" }"); }
+    out.put("\n  },\n  ");
+
+    putName(out, "histograms"); out.put('{');
+    for (int i = 0; i < histograms.size(); i++){
+        out.put(i == 0 ? "\n    " : ",\n    ");
+        putName(out, histograms[i].name); out.put('[');
+        for (int j = 0; j < histograms[i].size; j++){
+            if (j > 0) out.put(", ");
+            out.putInt(buckets[histograms[i].first + j]); }
+        out.put(']'); }
+    out.put("\n  },\n  ");
+
+    putName(out, "series"); out.put("{ \"columns\": [\"seconds\"");
+    for (int i = 0; i < columns.size(); i++){
+        out.put(", \""); out.put(columns[i]); out.put('"'); }
+    out.put("], \"rows\": [");
+    int width = columns.size() + 1;
+    for (int r = 0; r < series.size(); r += width){
+        out.put(r == 0 ? "\n    [" : ",\n    [");
+        for (int i = 0; i < width; i++){
+            if (i > 0) out.put(", ");
+            putDouble(out, series[r + i]); }
+        out.put(']'); }
+    out.put(" ] }\n}\n");
+}
+
+bool StatsRegistry::writeJSON(const char* file) const
+{
+    if (strcmp(file, "-") == 0){
+        WriteBuffer out(stderr);
+        writeJSON(out);
+        return out.flush(); }
+
+    FILE* f = fopen(file, "wb");
+    if (f == NULL) return false;
+    bool good;
+    {
+        WriteBuffer out(f);
+        writeJSON(out);
+        good = out.flush();
+    }
+    return fclose(f) == 0 && good;
+}
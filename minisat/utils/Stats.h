@@ -0,0 +1,128 @@
+/***************************************************************************************[Stats.h]
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT
+NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT
+OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+**************************************************************************************************/
+
+#ifndef Minisat_Stats_h
+#define Minisat_Stats_h
+
+#include <signal.h>
+#include <chrono>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+#include "minisat/mtl/IntTypes.h"
+#include "minisat/mtl/Vec.h"
+#include "minisat/utils/WriteUtils.h"
+
+namespace Minisat {
+
+//=================================================================================================
+// StatsRegistry -- named counters, timers, histograms and a time series, written as JSON:
+//
+// Counters either live in the registry ('add()') or are existing variables registered by address
+// ('bind()'), so a solver keeps its own statistics members. Timers count ticks of the time stamp
+// counter where there is one (nanoseconds otherwise), converted to seconds against the wall clock
+// when they are written. Names are not copied, they must outlive the registry (string literals).
+//
+// Building with 'MINISAT_NO_STATS' compiles the counting out: 'add()', 'sample()' and 'StatTimer'
+// do nothing, so they can stay on the hot paths. Bound counters and the time series remain.
+
+static inline uint64_t statTicks() {
+#if defined(__x86_64__) || defined(__i386__)
+    return __rdtsc();
+#else
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+#endif
+}
+
+class StatsRegistry {
+    typedef std::chrono::steady_clock Clock;
+
+    struct Counter   { const char* name; uint64_t value; const uint64_t* bound; };
+    struct Timer     { const char* name; uint64_t ticks; uint64_t calls; };
+    struct Histogram { const char* name; int first, size; };        // Buckets 'first..first+size-1' of 'buckets'.
+
+    vec<Counter>     counters;
+    vec<Timer>       timers;
+    vec<Histogram>   histograms;
+    vec<uint64_t>    buckets;
+    vec<const char*> columns;
+    vec<double>      series;        // Rows of the time series one after the other, each with the time and 'columns'.
+    Clock::time_point start_time;
+    uint64_t         start_ticks;
+
+    static volatile sig_atomic_t& dumpFlag() { static volatile sig_atomic_t flag = 0; return flag; }
+
+public:
+    StatsRegistry() : start_time(Clock::now()), start_ticks(statTicks()) {}
+
+    // Registration, each returns the id to count with:
+    int      counter      (const char* name)                  { Counter c = { name, 0, NULL }; counters.push(c); return counters.size() - 1; }
+    void     bind         (const char* name, const uint64_t* v){ Counter c = { name, 0, v }; counters.push(c); }
+    int      timer        (const char* name)                  { Timer t = { name, 0, 0 }; timers.push(t); return timers.size() - 1; }
+    int      histogram    (const char* name, int size)        { Histogram h = { name, buckets.size(), size }; histograms.push(h); buckets.growTo(buckets.size() + size, 0); return histograms.size() - 1; }
+    void     column       (const char* name)                  { assert(series.size() == 0); columns.push(name); }
+
+    // Counting (values beyond the last bucket of a histogram count in the last one):
+#ifndef MINISAT_NO_STATS
+    void     add          (int c, uint64_t n = 1)             { counters[c].value += n; }
+    void     sample       (int h, int v)                      { const Histogram& x = histograms[h]; buckets[x.first + (v < x.size ? v : x.size - 1)]++; }
+    void     time         (int t, uint64_t ticks)             { timers[t].ticks += ticks; timers[t].calls++; }
+#else
+    void     add          (int, uint64_t = 1)                 {}
+    void     sample       (int, int)                          {}
+    void     time         (int, uint64_t)                     {}
+#endif
+    void     record       (const double* row)                 { series.push(seconds()); for (int i = 0; i < columns.size(); i++) series.push(row[i]); }
+
+    uint64_t value        (int c)                       const { return counters[c].bound != NULL ? *counters[c].bound : counters[c].value; }
+    int      nTimers      ()                            const { return timers.size(); }
+    const char* timerName (int t)                       const { return timers[t].name; }
+    uint64_t timerCalls   (int t)                       const { return timers[t].calls; }
+    double   timerSeconds (int t)                       const;
+    double   seconds      ()                            const { return std::chrono::duration<double>(Clock::now() - start_time).count(); }
+
+    void     writeJSON    (WriteBuffer& out)            const;
+    bool     writeJSON    (const char* file)            const; // ("-" is standard error)
+
+    // For signal handlers: only sets a flag, which the solver checks regularly (see 'dumpRequested()').
+    static void requestDump   ()                              { dumpFlag() = 1; }
+    static bool dumpRequested ()                              { if (!dumpFlag()) return false; dumpFlag() = 0; return true; }
+};
+
+//=================================================================================================
+// StatTimer -- adds the time until it goes out of scope to a timer of a registry:
+
+class StatTimer {
+#ifndef MINISAT_NO_STATS
+    StatsRegistry& stats;
+    int            id;
+    uint64_t       start;
+public:
+    StatTimer(StatsRegistry& s, int t) : stats(s), id(t), start(statTicks()) {}
+    ~StatTimer() { stats.time(id, statTicks() - start); }
+#else
+public:
+    StatTimer(StatsRegistry&, int) {}
+#endif
+};
+
+//=================================================================================================
+}
+
+#endif
@@ -0,0 +1,94 @@
+/**********************************************************************************[WriteUtils.h]
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT
+NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT
+OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+**************************************************************************************************/
+
+#ifndef Minisat_WriteUtils_h
+#define Minisat_WriteUtils_h
+
+#include <assert.h>
+#include <stdio.h>
+#include <string.h>
+#include <ostream>
+
+#include <zlib.h>
+
+#include "minisat/mtl/IntTypes.h"
+#include "minisat/mtl/XAlloc.h"
+
+namespace Minisat {
+
+//-------------------------------------------------------------------------------------------------
+// A buffered output stream, the counterpart of 'StreamBuffer':
+//
+// Integers are formatted directly into one large buffer, which is handed to 'fwrite', 'gzwrite' or
+// 'std::ostream::write' when it is full. Nothing is allocated per call.
+
+class WriteBuffer {
+    enum { Size = 1048576 };
+
+    FILE*         file;
+    gzFile        gz;
+    std::ostream* stream;
+    char*         buf;
+    int           pos;
+    bool          failed;
+
+    void room(int n) { if (pos + n > Size) flush(); }
+
+    // Not copyable:
+    WriteBuffer(const WriteBuffer&);
+    WriteBuffer& operator=(const WriteBuffer&);
+
+public:
+    explicit WriteBuffer(FILE* f)         : file(f),    gz(NULL), stream(NULL), buf((char*)xrealloc(NULL, Size)), pos(0), failed(false) {}
+    explicit WriteBuffer(gzFile g)        : file(NULL), gz(g),    stream(NULL), buf((char*)xrealloc(NULL, Size)), pos(0), failed(false) {}
+    explicit WriteBuffer(std::ostream& s) : file(NULL), gz(NULL), stream(&s),   buf((char*)xrealloc(NULL, Size)), pos(0), failed(false) {}
+    ~WriteBuffer() { flush(); free(buf); }
+
+    // Returns false if anything could not be written (now or before):
+    bool flush() {
+        if (pos > 0){
+            if      (file   != NULL) failed |= fwrite(buf, 1, pos, file) != (size_t)pos;
+            else if (gz     != NULL) failed |= gzwrite(gz, buf, pos) != pos;
+            else if (stream != NULL) failed |= !stream->write(buf, pos);
+            pos = 0; }
+        return !failed; }
+
+    bool good() const { return !failed; }
+
+    void put(char c) { room(1); buf[pos++] = c; }
+
+    void put(const char* s) {
+        int n = strlen(s);
+        assert(n <= Size);
+        room(n);
+        memcpy(buf + pos, s, n);
+        pos += n; }
+
+    void putInt(int64_t v) {
+        char     tmp[20];
+        int      n = 0;
+        uint64_t u = v < 0 ? -(uint64_t)v : (uint64_t)v;
+        do { tmp[n++] = '0' + u % 10; u /= 10; } while (u != 0);
+        room(n + 1);
+        if (v < 0) buf[pos++] = '-';
+        while (n > 0) buf[pos++] = tmp[--n]; }
+};
+
+//=================================================================================================
+}
+
+#endif